@@ -3,30 +3,35 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 
 namespace alh {
 
-struct vec2_t {
-    float x, y;
-    friend vec2_t operator+(vec2_t const& lhs, vec2_t const& rhs) {return {lhs.x+rhs.x, lhs.y+rhs.y}; }
-    friend vec2_t operator-(vec2_t const& lhs, vec2_t const& rhs) {return {lhs.x-rhs.x, lhs.y-rhs.y}; }
-    friend vec2_t operator*(vec2_t const& lhs, float const& rhs) {return {lhs.x*rhs, lhs.y*rhs}; }
-    friend vec2_t operator/(vec2_t const& lhs, float const& rhs) {return {lhs.x/rhs, lhs.y/rhs}; }
-    friend bool operator==(vec2_t const& lhs, vec2_t const& rhs) { return (lhs.x==rhs.x && lhs.y==rhs.y); }
-    friend bool operator!=(vec2_t const& lhs, vec2_t const& rhs) { return !(lhs == rhs); }
+template<typename T>
+struct basic_vec2_t {
+    T x, y;
+    friend basic_vec2_t operator+(basic_vec2_t const& lhs, basic_vec2_t const& rhs) {return {lhs.x+rhs.x, lhs.y+rhs.y}; }
+    friend basic_vec2_t operator-(basic_vec2_t const& lhs, basic_vec2_t const& rhs) {return {lhs.x-rhs.x, lhs.y-rhs.y}; }
+    friend basic_vec2_t operator*(basic_vec2_t const& lhs, T const& rhs) {return {lhs.x*rhs, lhs.y*rhs}; }
+    friend basic_vec2_t operator/(basic_vec2_t const& lhs, T const& rhs) {return {lhs.x/rhs, lhs.y/rhs}; }
+    friend bool operator==(basic_vec2_t const& lhs, basic_vec2_t const& rhs) { return (lhs.x==rhs.x && lhs.y==rhs.y); }
+    friend bool operator!=(basic_vec2_t const& lhs, basic_vec2_t const& rhs) { return !(lhs == rhs); }
     
     // todo: avoid all uses of is_left_of with a cross product and remove method
     bool is_left_of(auto l) const {
-        vec2_t dl = l.q - l.p;
+        basic_vec2_t dl = l.q - l.p;
         return (x - l.p.x)*(-dl.y) + (y - l.p.y)*(dl.x) < 0;
     }
 
     bool is_exactly_on(auto l) const {
-        vec2_t dl = l.q - l.p;
+        basic_vec2_t dl = l.q - l.p;
         return (x - l.p.x)*(-dl.y) + (y - l.p.y)*(dl.x) == 0;
     }
 };
 
+using vec2_t = basic_vec2_t<float>;
+using vec2i_t = basic_vec2_t<int32_t>; // fixed point, see bsp::to_fixed()
+
 static float cross(vec2_t a, vec2_t b) {
     return (a.x*b.y - b.x*a.y);
 }
@@ -5,11 +5,17 @@
 #include <cstdint>
 #include <cmath>
 #include <limits>
+#include <memory_resource>
+#include <span>
 #include <vector>
 #include <algorithm>
 
 #include "alh.hpp"
 
+namespace alh {
+    struct thread_pool_t;
+}
+
 namespace alh::bsp {
 
     using id_t = uint32_t;
@@ -50,7 +56,98 @@ namespace alh::bsp {
         id_t right, left;
     };
 
-    using bsp_t = typename std::vector<bsp_node_t>;
+    // traversal record for a node, the plane is nx*x + ny*y = d with unit normal
+    // pointing to the right of the node segment (points left of it are behind)
+    struct bsp_plane_t {
+        float nx, ny, d;
+        id_t right, left;
+
+        float dot(vec2_t const& p) const {
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+            return std::fma(nx, p.x, ny * p.y);
+#else
+            return nx * p.x + ny * p.y;
+#endif
+        }
+
+        bool is_left(vec2_t const& p) const { return dot(p) < d; }
+        id_t child(vec2_t const& p) const { return is_left(p) ? left : right; }
+
+        // param t where p + (q - p) * t meets the plane, p and q on opposite sides
+        float intersect(vec2_t const& p, vec2_t const& q) const {
+            return (d - dot(p)) / dot(q - p);
+        }
+    };
+
+    static_assert(sizeof(bsp_plane_t) == 20);
+
+    // box around the segments of a node and all nodes below it
+    struct bsp_bounds_t {
+        vec2_t min, max;
+    };
+
+    // the vectors allocate from a memory resource, the global heap unless the tree was
+    // made with another one (see build_options_t::memory). a copy uses the global heap
+    struct bsp_t {
+        std::pmr::vector<bsp_plane_t> planes; // hot, used by queries
+        std::pmr::vector<bsp_node_t> nodes; // cold, segments and userdata for boolean ops and navmesh
+        std::pmr::vector<bsp_bounds_t> bounds; // optional, see compute_bounds()
+
+        // planes[i] and nodes[i] are the same node, read access goes to the nodes
+        size_t size() const { return nodes.size(); }
+        bool empty() const { return nodes.empty(); }
+        bsp_node_t const& operator[](size_t i) const { return nodes[i]; }
+        bsp_node_t const& front() const { return nodes.front(); }
+        auto begin() const { return nodes.begin(); }
+        auto end() const { return nodes.end(); }
+    };
+
+    // serialized node segment, see serialize() for the layout
+    struct flat_node_t {
+        float px, py, qx, qy;
+        float t1, t2;
+        id_t right, left;
+    };
+
+    static_assert(sizeof(flat_node_t) == 32);
+
+    // read-only tree that points into a serialized buffer (e.g. a memory-mapped file)
+    struct bsp_view_t {
+        bsp_plane_t const* planes;
+        flat_node_t const* nodes;
+        size_t size;
+    };
+
+    // fixed point coordinates are int32 in units of 1 / FIXED_ONE, within FIXED_LIMIT
+    // of the origin. that keeps the plane tests of fixed_plane_t exact in int64
+    static constexpr int32_t FIXED_SHIFT = 8;
+    static constexpr int32_t FIXED_ONE = 1 << FIXED_SHIFT;
+    static constexpr int32_t FIXED_LIMIT = 1 << 29;
+
+    // plane a*x + b*y = c through the fixed point ends of a node line, (a, b) points to
+    // the right of it as in bsp_plane_t but isn't unit length. no rounding happens in
+    // the test, the same point is on the same side on every machine
+    struct fixed_plane_t {
+        int32_t a, b;
+        int64_t c;
+        id_t right, left;
+
+        int64_t side(vec2i_t const& p) const { return (int64_t)a * p.x + (int64_t)b * p.y - c; }
+        bool is_left(vec2i_t const& p) const { return side(p) < 0; }
+        id_t child(vec2i_t const& p) const { return is_left(p) ? left : right; }
+    };
+
+    static_assert(sizeof(fixed_plane_t) == 24);
+
+    // fixed point copy of a bsp_t for queries that must give bit identical results
+    // everywhere (e.g. lockstep simulation). node and leaf ids are those of the tree it
+    // was made from, which keeps the segments and userdata
+    struct fixed_bsp_t {
+        std::vector<fixed_plane_t> planes;
+
+        size_t size() const { return planes.size(); }
+        bool empty() const { return planes.empty(); }
+    };
 
     struct clip_context_t;
     typedef bool (*leaf_callback)(clip_context_t &ctx, float t1, float t2, void *userdata);
@@ -63,22 +160,253 @@ namespace alh::bsp {
         void *userdata; // used for output, etc.
     };
 
-    bsp_t build(std::vector<line_t> lines);
-    bsp_t build(std::vector<paramline_t> paramlines);
+    enum class split_heuristic_t {
+        geometric_mean, // segment with its midpoint closest to the mean of all midpoints
+        sampled_cost, // best scoring of n_samples candidates, see build_options_t
+    };
+
+    struct build_options_t {
+        split_heuristic_t heuristic = split_heuristic_t::geometric_mean;
+
+        // sampled_cost: score = split_weight * segments cut + balance_weight * |left - right|
+        // + traversal_weight * expected segments on the side a query ends up in
+        uint32_t n_samples = 16;
+        float split_weight = 4.f;
+        float balance_weight = 0.5f;
+        float traversal_weight = 1.f;
+
+        // build right subtrees of at least task_grain segments as pool tasks, the
+        // tree is the same as without a pool
+        thread_pool_t *pool = nullptr;
+        uint32_t task_grain = 2048;
+
+        // fill bsp_t::bounds, see compute_bounds()
+        bool node_bounds = false;
+
+        // depth to keep to, 0 for none. once a subtree of n segments is deeper than
+        // max_depth - log2(n), its planes are picked to halve it (the best balanced of
+        // n_samples candidates) instead of by the heuristic. segments that can't be
+        // split evenly may still go past it: a convex outline is a chain, and so are
+        // segments on one line since each of them is a node
+        uint32_t max_depth = 0;
+
+        // the tree and the scratch of the calling thread are allocated from memory, which
+        // has to outlive the tree. pool tasks use the global heap, so memory doesn't
+        // need to be thread safe. nullptr is the global heap
+        std::pmr::memory_resource *memory = nullptr;
+    };
+
+    struct build_stats_t {
+        uint32_t depth; // nodes on the longest root to leaf path
+        uint32_t node_count;
+        uint32_t leaf_count;
+        uint32_t splits; // segments cut in two by a hyperplane
+        uint32_t balanced; // nodes whose plane was picked for balance, see max_depth
+    };
+
+    bsp_t build(std::vector<line_t> lines, build_options_t const& options = {}, build_stats_t *stats = nullptr);
+    bsp_t build(std::vector<paramline_t> paramlines, build_options_t const& options = {}, build_stats_t *stats = nullptr);
+    bsp_plane_t make_plane(paramline_t const& plane, id_t right, id_t left);
     
     bool is_solid(bsp_t const& bsp, id_t nid, vec2_t const& point);
     id_t leaf_id(bsp_t const& bsp, id_t nid, vec2_t const& point);
     bool sweep(bsp_t const& bsp, line_t const& line, vec2_t &intersection, line_t &intersected);
+
+    // is_solid and leaf_id for many points at once, walks the tree with simd packets
+    // where available. either output may be empty, otherwise it matches points in size
+    void classify_points(bsp_t const& bsp, std::span<vec2_t const> points, std::span<uint8_t> solid, std::span<id_t> leaf_ids);
+
+    struct sweep_hit_t {
+        bool hit;
+        vec2_t point; // same as sweep() intersection
+        line_t plane; // same as sweep() intersected
+    };
+
+    // sweep() for each of many lines. runs of 64 lines walk down together until the first
+    // plane that cuts the box around them, so lines close to each other in the span and
+    // in space (agents of one group, rays to one target) save most. hits matches lines
+    // in size, a pool spreads large batches over its threads
+    void sweep_many(bsp_t const& bsp, std::span<line_t const> lines, std::span<sweep_hit_t> hits, thread_pool_t *pool = nullptr);
+
+    // leaves are reported in order along the line. with bounds, a run of leaves that
+    // has no segment of the tree in it may come as one call
     bool clip(clip_context_t &ctx, id_t root);
+
+    // same as slide_move(bsp, p1, p2).position
     void dot_solve(bsp_t const& bsp, vec2_t const& p1, vec2_t &p2);
 
-    void serialize(bsp_t const& in);
-    bsp_t deserialize(uint8_t *data, size_t len);
+    static constexpr uint32_t MAX_MOVE_CONTACTS = 4;
+    static constexpr float MOVE_SKIN = 0.1f; // distance kept from walls
+
+    struct move_result_t {
+        vec2_t position;
+        uint32_t n_contacts;
+        vec2_t normals[MAX_MOVE_CONTACTS]; // of the walls touched, in order, pointing away from them
+    };
+
+    // move from p1 towards p2, sliding along the walls in the way. each contact sweeps
+    // only the rest of the move from where it stopped, and there are at most
+    // MAX_MOVE_CONTACTS of them. the move stops in a corner, and doesn't start from solid
+    move_result_t slide_move(bsp_t const& bsp, vec2_t const& p1, vec2_t const& p2);
+
+    // slide_move() for many movers, out matches from and to in size. a pool spreads
+    // large batches over its threads
+    void slide_move_many(bsp_t const& bsp, std::span<vec2_t const> from, std::span<vec2_t const> to, std::span<move_result_t> out, thread_pool_t *pool = nullptr);
+
+    // convex polygon, edge k runs from verts[k] to verts[k+1] (wrapping) and lies on
+    // the plane of node tags[k], NULL_ID for edges that came with the polygon
+    struct convex_poly_t {
+        std::pmr::vector<vec2_t> verts;
+        std::pmr::vector<id_t> tags;
+    };
+
+    // split poly by the plane h of node nid into its right and left parts, the new
+    // edges are tagged nid. a part with less than three vertices comes back empty
+    void split_poly(convex_poly_t const& poly, bsp_plane_t const& h, id_t nid, convex_poly_t &right, convex_poly_t &left);
+
+    // view() rejects a buffer with a bad header, size or child id, deserialize() gives
+    // an empty tree for it. view() also needs a little-endian host and a 4-byte aligned
+    // buffer, deserialize() copies the fields and does not
+    std::vector<uint8_t> serialize(bsp_t const& in);
+    bsp_t deserialize(uint8_t const* data, size_t len);
+    bool view(uint8_t const* data, size_t len, bsp_view_t &out);
+
+    bool is_solid(bsp_view_t const& bsp, id_t nid, vec2_t const& point);
+    id_t leaf_id(bsp_view_t const& bsp, id_t nid, vec2_t const& point);
+    bool sweep(bsp_view_t const& bsp, line_t const& line, vec2_t &intersection, line_t &intersected);
+    void classify_points(bsp_view_t const& bsp, std::span<vec2_t const> points, std::span<uint8_t> solid, std::span<id_t> leaf_ids);
+
+    // rounds to the nearest fixed point, p must be within FIXED_LIMIT / FIXED_ONE
+    vec2i_t to_fixed(vec2_t const& p);
+    vec2_t from_fixed(vec2i_t const& p);
+
+    // node lines are rounded to fixed point, so points closer to a segment than about
+    // 1 / FIXED_ONE may be classified differently than by bsp
+    fixed_bsp_t to_fixed(bsp_t const& bsp);
+
+    bool is_solid(fixed_bsp_t const& bsp, id_t nid, vec2i_t const& point);
+    id_t leaf_id(fixed_bsp_t const& bsp, id_t nid, vec2i_t const& point);
+
+    // the line is classified exactly, only the params where it crosses planes are
+    // rounded. hit is the start of the first solid part rounded towards p, and hit_nid
+    // the node whose plane began it, NULL_ID when p is in solid
+    bool sweep(fixed_bsp_t const& bsp, vec2i_t const& p, vec2i_t const& q, vec2i_t &hit, id_t &hit_nid);
+
+    // per node bounds let sweep(), sweep_many() and clip() pass through a subtree as a
+    // point when the line misses its box, instead of splitting at every plane below.
+    // that needs solid to change only across segments, as in trees built from closed
+    // outlines. the in place edits keep the bounds up to date, the other functions
+    // that make new trees don't compute them
+    void compute_bounds(bsp_t &bsp);
+
+    // box around min..max with a margin of half its size and one unit, counter-clockwise
+    // from min with NULL_ID tags. cells cut from it that only reach past the extent
+    // stay large, e.g. the open cells of a map
+    convex_poly_t bounds_poly(vec2_t const& min, vec2_t const& max, std::pmr::memory_resource *memory = nullptr);
+
+    // boolean ops merge the trees: one keeps its nodes and the other is copied into its
+    // leaves, without the nodes that don't cut the leaf cell. points are classified as
+    // by the operands, node segments are those of the operands and not clipped to the
+    // boundary. an empty tree is an empty operand, and an empty result. memory is as for
+    // build_options_t::memory
+    bsp_t union_op(bsp_t const& a, bsp_t const& b, std::pmr::memory_resource *memory = nullptr);
+    bsp_t intersect_op(bsp_t const& a, bsp_t const& b, std::pmr::memory_resource *memory = nullptr);
+    bsp_t difference_op(bsp_t const& a, bsp_t const& b, std::pmr::memory_resource *memory = nullptr);
+    bsp_t xor_op(bsp_t const& a, bsp_t const& b, std::pmr::memory_resource *memory = nullptr);
+
+    // new tree with the same solid and empty regions, built with options from the
+    // boundary between them (e.g. with max_depth to flatten a lopsided tree). node
+    // segments are the pieces of the old ones on the boundary, merged where they meet
+    // on a line, so nodes that don't separate solid from empty go away. leaf ids are
+    // new. a tree without a boundary comes back as a copy
+    bsp_t rebalance(bsp_t const& bsp, build_options_t const& options = {}, build_stats_t *stats = nullptr);
+
+    // union of all trees, merged pairwise in a balanced order. a pool merges the pairs
+    // of each level in parallel, the result is the same as without
+    bsp_t union_all(std::span<bsp_t const> trees, thread_pool_t *pool = nullptr);
 
-    bsp_t union_op(bsp_t const& a, bsp_t const& b);
-    bsp_t intersect_op(bsp_t const& a, bsp_t const& b);
-    bsp_t difference_op(bsp_t const& a, bsp_t const& b);
-    bsp_t xor_op(bsp_t const& a, bsp_t const& b);
+    // edit the tree in place with a convex polygon (either winding): insert makes its
+    // area solid, remove makes it empty. only leaves whose cell overlaps the polygon are
+    // replaced, by subtrees on the polygon edges, the rest keeps its nodes. nodes left
+    // with two leaves of the same kind are merged away. changed_leaves gets the sorted
+    // ids of leaves whose cell was replaced, added, grown or renumbered, ids at or above
+    // the new leaf count (size() + 1) are gone
+    void insert_obstacle(bsp_t &bsp, std::span<vec2_t const> poly, std::vector<id_t> &changed_leaves);
+    void remove_obstacle(bsp_t &bsp, std::span<vec2_t const> poly, std::vector<id_t> &changed_leaves);
+
+    // query counters, counted only when bsp.cpp is built with ALH_BSP_STATS defined,
+    // without it they stay zero and the queries don't touch them
+    struct query_stats_t {
+        uint64_t queries; // query calls, batches count each line or point
+        uint64_t nodes; // plane tests on the way down
+        uint64_t splits; // line parts cut in two at a plane by sweeps and clip
+        uint32_t max_stack; // most parts waiting on a traversal stack at once
+        uint64_t move_legs; // sweeps made by slide_move() and dot_solve()
+
+        query_stats_t &operator+=(query_stats_t const& o) {
+            queries += o.queries;
+            nodes += o.nodes;
+            splits += o.splits;
+            max_stack = std::max(max_stack, o.max_stack);
+            move_legs += o.move_legs;
+            return *this;
+        }
+    };
+
+    // whether the counters are compiled in
+    bool query_stats_enabled();
+
+    // counters of the calling thread, a pool thread counts into its own. for the
+    // counts of one query, clear them with query_stats() = {} before it
+    query_stats_t &query_stats();
+
+    struct tree_stats_t {
+        uint32_t node_count;
+        uint32_t solid_leaves, empty_leaves;
+        uint32_t depth; // nodes on the longest root to leaf path
+        float mean_depth; // of the leaves, each counted once
+        std::vector<uint32_t> depth_histogram; // leaves by the number of nodes above them
+
+        // node segments that are only a part of their line, which build() makes by
+        // cutting segments at a plane (the in place edits make some too)
+        uint32_t split_segments;
+        size_t bytes; // held by the tree vectors
+    };
+
+    tree_stats_t tree_stats(bsp_t const& bsp);
+
+    // passes allocations on to upstream and counts them, e.g. to report the bytes an
+    // operation allocates. not thread safe, like std::pmr::monotonic_buffer_resource
+    struct counting_resource_t : std::pmr::memory_resource {
+        std::pmr::memory_resource *upstream;
+        size_t n_allocs = 0;
+        size_t bytes = 0; // all allocated so far
+        size_t current = 0, peak = 0; // allocated and not freed
+
+        explicit counting_resource_t(std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) : upstream(upstream) { }
+
+        // start counting again, what is still allocated stays in current
+        void reset() {
+            n_allocs = 0;
+            bytes = 0;
+            peak = current;
+        }
+
+    private:
+        void *do_allocate(size_t n, size_t align) override {
+            n_allocs++;
+            bytes += n;
+            peak = std::max(peak, current += n);
+            return upstream->allocate(n, align);
+        }
+
+        void do_deallocate(void *p, size_t n, size_t align) override {
+            current -= n;
+            upstream->deallocate(p, n, align);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+    };
 
 } // namespace alh::bsp
 
@@ -1,6 +1,9 @@
-
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <string>
+#include <unordered_map>
 
 #include "alh.hpp"
 #include "bsp.hpp"
@@ -10,62 +13,224 @@
 
 namespace alh::bsp {
 
-    bsp_t from_stl(const uint8_t *data, size_t len) {
-        // build bsp from the union of .stl triangles
-        assert(sizeof(float) == 4);
-        assert(len > 84);
-        size_t off = 80; // skip header
+    // edges are matched on endpoints snapped to this grid
+    constexpr float STL_QUANTUM = 1.f / 8192.f;
 
-        uint32_t n_tris = 0;
-        std::memcpy(&n_tris, data + off, 4); // get number of triangles
-        off += 4;
-        assert(n_tris > 0);
+    struct stl_edge_key_t {
+        int64_t px, py, qx, qy;
+        bool operator==(stl_edge_key_t const&) const = default;
+    };
+
+    struct stl_edge_hash_t {
+        size_t operator()(stl_edge_key_t const& k) const {
+            uint64_t h = 0xcbf29ce484222325ull;
+            for (int64_t v : {k.px, k.py, k.qx, k.qy}) h = (h ^ (uint64_t)v) * 0x100000001b3ull;
+            return h ^ (h >> 29);
+        }
+    };
 
-        // turn triangles into lines
+    // triangle edges of an .stl, an edge and its reverse cancel out so only the
+    // outline of the union of the triangles remains
+    struct stl_edges_t {
         std::vector<line_t> lines;
-        lines.reserve(n_tris * 3);
-        for(size_t n=0; n<n_tris && off<len; n++, off+=50) {
-            vec2_t v1, v2, v3; // (skip z component)
-            memcpy(&v1, data + off + 12, 8);
-            memcpy(&v2, data + off + 24, 8);
-            memcpy(&v3, data + off + 36, 8);
-
-            line_t l1, l2, l3;
+        std::vector<uint8_t> removed;
+        std::vector<uint32_t> next; // next unmatched edge with the same key
+        std::unordered_map<stl_edge_key_t, uint32_t, stl_edge_hash_t> open; // first unmatched edge per key
+
+        static stl_edge_key_t key(vec2_t p, vec2_t q) {
+            return {llroundf(p.x / STL_QUANTUM), llroundf(p.y / STL_QUANTUM),
+                    llroundf(q.x / STL_QUANTUM), llroundf(q.y / STL_QUANTUM)};
+        }
+
+        void add_edge(line_t const& l) {
+            if (l.p == l.q) return;
+
+            // cancel against an unmatched reverse edge
+            if (auto it = open.find(key(l.q, l.p)); open.end() != it) {
+                uint32_t i = it->second;
+                removed[i] = 1;
+                if (NULL_ID == next[i]) open.erase(it);
+                else it->second = next[i];
+                return;
+            }
+
+            uint32_t i = lines.size();
+            lines.push_back(l);
+            removed.push_back(0);
+            next.push_back(NULL_ID);
+            auto [it, b_new] = open.try_emplace(key(l.p, l.q), i);
+            if (!b_new) {
+                next[i] = it->second;
+                it->second = i;
+            }
+        }
+
+        void add_triangle(vec2_t v1, vec2_t v2, vec2_t v3) {
+            // (skip z component), wind counter-clockwise so the inside is empty
             if (cross(v1 - v3, v2 - v3) > 0.f) {
-                l1 = {v1, v2};
-                l2 = {v2, v3};
-                l3 = {v3, v1};
+                add_edge({v1, v2});
+                add_edge({v2, v3});
+                add_edge({v3, v1});
             } else {
-                l1 = {v1, v3};
-                l2 = {v3, v2};
-                l3 = {v2, v1};
+                add_edge({v1, v3});
+                add_edge({v3, v2});
+                add_edge({v2, v1});
             }
+        }
+
+        // remaining edges in the order they were added
+        std::vector<line_t> outline() const {
+            std::vector<line_t> out;
+            for (size_t i=0; i<lines.size(); i++)
+                if (!removed[i]) out.push_back(lines[i]);
+            return out;
+        }
+    };
 
-            lines.push_back(l1);
-            lines.push_back(l2);
-            lines.push_back(l3);
+    // bytes of an .stl from memory (e.g. a mapped file) or a FILE*, read front to back
+    struct stl_source_t {
+        uint8_t const* data = nullptr;
+        size_t len = 0, off = 0;
+        FILE *file = nullptr;
+
+        size_t read(void *out, size_t n) {
+            if (file) return fread(out, 1, n, file);
+            n = std::min(n, len - off);
+            memcpy(out, data + off, n);
+            off += n;
+            return n;
         }
+    };
+
+    void stl_read_binary(stl_source_t &src, uint8_t const* header, stl_edges_t &edges) {
+        uint32_t n_tris = 0;
+        std::memcpy(&n_tris, header + 80, 4); // get number of triangles, the outline is empty for 0
 
-        // remove diagonals
-        for (size_t i=0; i<lines.size(); i++) {
-            for (size_t j=i+1; j<lines.size(); j++) {
-                line_t l1 = lines[i];
-                line_t l2 = lines[j];
-                if (l1.p == l2.q && l1.q == l2.p) {
-                    lines[i] = lines[lines.size() - 1];
-                    lines[j] = lines[lines.size() - 2];
-                    lines.pop_back();
-                    lines.pop_back();
-                    i -= 1;
-                    break;
+        // triangles are 50 bytes: normal, 3 vertices, attribute
+        constexpr size_t CHUNK = 1024;
+        std::vector<uint8_t> buf(CHUNK * 50);
+        for (size_t n=0; n<n_tris;) {
+            size_t n_chunk = std::min<size_t>(CHUNK, n_tris - n);
+            size_t n_read = src.read(buf.data(), n_chunk * 50) / 50;
+            for (size_t k=0; k<n_read; k++) {
+                vec2_t v1, v2, v3;
+                memcpy(&v1, buf.data() + k * 50 + 12, 8);
+                memcpy(&v2, buf.data() + k * 50 + 24, 8);
+                memcpy(&v3, buf.data() + k * 50 + 36, 8);
+                edges.add_triangle(v1, v2, v3);
+            }
+            if (n_read < n_chunk) break; // truncated file
+            n += n_read;
+        }
+    }
+
+    void stl_read_ascii(stl_source_t &src, uint8_t const* header, size_t header_len, stl_edges_t &edges) {
+        // only "vertex x y z" matters, every three make a triangle
+        std::vector<char> buf(header, header + header_len);
+        std::vector<char> chunk(1 << 16);
+        std::string token;
+        vec2_t v[3];
+        int n_vertex = 0, n_coord = -1; // coord of the current vertex, -1 outside one
+        float coord[3];
+
+        auto on_token = [&]() {
+            if (n_coord >= 0) {
+                coord[n_coord++] = strtof(token.c_str(), nullptr);
+                if (3 == n_coord) {
+                    v[n_vertex++] = {coord[0], coord[1]};
+                    n_coord = -1;
+                    if (3 == n_vertex) {
+                        edges.add_triangle(v[0], v[1], v[2]);
+                        n_vertex = 0;
+                    }
+                }
+            } else if ("vertex" == token) {
+                n_coord = 0;
+            }
+            token.clear();
+        };
+
+        for (;;) {
+            for (char c : buf) {
+                if (' ' == c || '\t' == c || '\n' == c || '\r' == c) {
+                    if (!token.empty()) on_token();
+                } else {
+                    token.push_back(c);
                 }
             }
+            size_t n = src.read(chunk.data(), chunk.size());
+            if (0 == n) break;
+            buf.assign(chunk.begin(), chunk.begin() + n);
+        }
+        if (!token.empty()) on_token();
+    }
+
+    // binary unless it starts with "solid" and, when the size is known, does not
+    // match the binary size for its triangle count
+    std::vector<line_t> stl_read_outline(stl_source_t &src, size_t total_len) {
+        uint8_t header[84];
+        size_t n_header = src.read(header, 84);
+        if (n_header < 5) return {}; // too short for either format
+
+        bool b_ascii = (0 == memcmp(header, "solid", 5));
+        if (b_ascii && 84 == n_header && 0 != total_len) {
+            uint32_t n_tris = 0;
+            std::memcpy(&n_tris, header + 80, 4);
+            b_ascii = (84 + (size_t)n_tris * 50 != total_len);
         }
 
-        bsp_t bsp = build(lines);
+        stl_edges_t edges;
+        if (b_ascii) {
+            stl_read_ascii(src, header, n_header, edges);
+        } else {
+            if (n_header < 84) return {}; // truncated binary header
+            stl_read_binary(src, header, edges);
+        }
+
+        return edges.outline();
+    }
+
+    bsp_t stl_read(stl_source_t &src, size_t total_len) {
+        std::vector<line_t> outline = stl_read_outline(src, total_len);
+        if (outline.empty()) return {}; // short input or no triangles
+        bsp_t bsp = build(std::move(outline));
         return bsp;
     }
 
+    // outline of the union of .stl triangles, for building with other options
+    // empty for input that is too short or has no triangles
+    std::vector<line_t> stl_outline(const uint8_t *data, size_t len) {
+        stl_source_t src;
+        src.data = data;
+        src.len = len;
+        return stl_read_outline(src, len);
+    }
+
+    bsp_t from_stl(const uint8_t *data, size_t len) {
+        // build bsp from the union of .stl triangles, empty for short input
+        assert(sizeof(float) == 4);
+        stl_source_t src;
+        src.data = data;
+        src.len = len;
+        return stl_read(src, len);
+    }
+
+    bsp_t from_stl(FILE *file) {
+        // same as above, reads the file in chunks instead of loading it whole
+        assert(file);
+        size_t total_len = 0;
+        long start = ftell(file);
+        if (start >= 0 && 0 == fseek(file, 0, SEEK_END)) { // size is unknown for pipes
+            long end = ftell(file);
+            if (end > start) total_len = end - start;
+            fseek(file, start, SEEK_SET);
+        }
+
+        stl_source_t src;
+        src.file = file;
+        return stl_read(src, total_len);
+    }
+
 } // namespace alh::bsp
 
-#endif
\ No newline at end of file
+#endif
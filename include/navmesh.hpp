@@ -2,11 +2,14 @@
 #define ALH_NAVMESH_HPP
 
 #include <cassert>
+#include <chrono>
 #include <vector>
 #include <algorithm>
+#include <bit>
 
 #include "alh.hpp"
 #include "bsp.hpp"
+#include "thread_pool.hpp"
 
 namespace alh::bsp::navmesh {
 
@@ -46,8 +49,10 @@ void bsp_bb(bsp_t const& bsp, vec2_t &min, vec2_t &max) {
     }
 }
 
-// get polygon for a specific leaf id
-bsp_t leaf_poly(bsp_t const& bsp, id_t leaf_id) {
+// get polygon for a specific leaf id, the tree and its scratch are allocated from memory
+// as for build_options_t::memory
+bsp_t leaf_poly(bsp_t const& bsp, id_t leaf_id, std::pmr::memory_resource *memory = nullptr) {
+    if (!memory) memory = std::pmr::get_default_resource();
 
     // find parent node with leaf id
     bool is_left = false;
@@ -60,32 +65,102 @@ bsp_t leaf_poly(bsp_t const& bsp, id_t leaf_id) {
     assert(false); // leaf id not in tree!
 found:
 
-    // create first plane
-    paramline_t plane = bsp[parent].plane;
-    plane.t1 = -1000.f;
-    plane.t2 = 1000.f;
-    plane.line.userdata = (void *)(size_t) parent;
-    if (!is_left) plane.flip();
-    bsp_t poly = bsp::build({plane});
-
-    // clip against parent planes
-    id_t prev = parent;
+    // path from the root down to the leaf
+    std::vector<std::pair<id_t, bool>> path = {{parent, is_left}};
     std::vector<id_t> parents = parent_list(bsp);
-    while(NULL_ID != parents[parent]) {
-        parent = parents[parent];
+    for (id_t i=parent; NULL_ID != parents[i]; i=parents[i])
+        path.push_back({parents[i], bsp[parents[i]].left == i});
+    std::reverse(path.begin(), path.end());
+
+    // cut the bounding box down to the leaf cell, same as cells() does
+    vec2_t min, max;
+    bsp_bb(bsp, min, max);
+    convex_poly_t poly = bounds_poly(min, max, memory);
+    convex_poly_t right{std::pmr::vector<vec2_t>(memory), std::pmr::vector<id_t>(memory)};
+    convex_poly_t left{std::pmr::vector<vec2_t>(memory), std::pmr::vector<id_t>(memory)};
+    for (auto [nid, b_left] : path) {
+        split_poly(poly, bsp.planes[nid], nid, right, left);
+        poly = b_left ? left : right;
+        assert(!poly.verts.empty());
+    }
+
+    // edges against the winding of the cell so that it is solid, edges on node planes
+    // carry the node id
+    std::vector<line_t> lines;
+    lines.reserve(poly.verts.size());
+    for (size_t k=0; k<poly.verts.size(); k++) {
+        line_t l = {poly.verts[(k + 1) % poly.verts.size()], poly.verts[k]};
+        l.userdata = (void *)(size_t) poly.tags[k];
+        lines.push_back(l);
+    }
+    build_options_t options;
+    options.memory = memory;
+    return bsp::build(std::move(lines), options);
+}
 
-        paramline_t plane = bsp[parent].plane;
-        plane.t1 = -1000.f;
-        plane.t2 = 1000.f;
-        plane.line.userdata = (void *)(size_t) parent;
-        assert(bsp[parent].left == prev || bsp[parent].right == prev);
-        if (bsp[parent].left == prev) plane.flip();
-        poly = difference_op(poly, bsp::build({plane}));
+struct cells_t {
+    std::vector<id_t> leaf_ids; // empty leaf of each cell
+    std::vector<vec2_t> centers; // mean of the cell vertices
+    std::vector<size_t> cell_start; // edges of cell i are [cell_start[i], cell_start[i+1])
 
-        prev = parent;
+    // edges on node planes, the plane is the node's line with userdata set to the node
+    // id and t1, t2 the ends of the edge on it. edges of the bounds are left out
+    std::vector<bsp_node_t> edges;
+};
+
+// convex polygons of all empty leaves in one walk from the root, each node splits the
+// polygon that reaches it and hands the parts to its children
+cells_t cells(bsp_t const& bsp) {
+    cells_t out;
+    if (bsp.empty()) return out;
+
+    // start with the bounding box, with some margin for open maps
+    vec2_t min, max;
+    bsp_bb(bsp, min, max);
+    convex_poly_t bounds = bounds_poly(min, max);
+
+    std::vector<std::pair<id_t, convex_poly_t>> stack;
+    stack.push_back({0, std::move(bounds)});
+    convex_poly_t right, left;
+
+    while (!stack.empty()) {
+        auto [nid, poly] = std::move(stack.back());
+        stack.pop_back();
+
+        if (solid_leaf(nid)) continue;
+        if (empty_leaf(nid)) {
+            vec2_t acc = {0.f, 0.f};
+            for (vec2_t const& v : poly.verts) acc = acc + v;
+            out.leaf_ids.push_back((nid & ~IS_LEAF) & ~IS_SOLID);
+            out.centers.push_back(acc / poly.verts.size());
+            out.cell_start.push_back(out.edges.size());
+
+            for (size_t k=0; k<poly.verts.size(); k++) {
+                if (NULL_ID == poly.tags[k]) continue;
+                line_t l = bsp[poly.tags[k]].plane.line;
+                l.userdata = (void *)(size_t) poly.tags[k];
+
+                // position of both ends along the node line
+                vec2_t pq = l.q - l.p;
+                float len2 = pq.x*pq.x + pq.y*pq.y;
+                vec2_t a = poly.verts[k] - l.p;
+                vec2_t b = poly.verts[(k + 1) % poly.verts.size()] - l.p;
+                paramline_t edge; // edges can be shorter than the paramline_t ctor allows
+                edge.line = l;
+                edge.t1 = (a.x*pq.x + a.y*pq.y) / len2;
+                edge.t2 = (b.x*pq.x + b.y*pq.y) / len2;
+                out.edges.push_back({edge, NULL_ID, NULL_ID});
+            }
+            continue;
+        }
+
+        split_poly(poly, bsp.planes[nid], nid, right, left);
+        if (!right.verts.empty()) stack.push_back({bsp.planes[nid].right, right});
+        if (!left.verts.empty()) stack.push_back({bsp.planes[nid].left, left});
     }
+    out.cell_start.push_back(out.edges.size());
 
-    return poly;
+    return out;
 }
 
 struct nav_node_t {
@@ -112,96 +187,73 @@ navmesh_t build(bsp_t const& bsp) {
         if (is_leaf(node.right)) n_leaves++;
     }
 
-    bsp_t cells;
-    std::vector<id_t> empty_ids = empty_leaves(bsp);
-    std::vector<size_t> cell_start;
-    cell_start.reserve(empty_ids.size() + 1);
-
     // generate polygons for empty leaves
-    for (id_t id : empty_ids) {
-        bsp_t poly = leaf_poly(bsp, id);
-        cell_start.push_back(cells.size());
-        cells.insert(cells.end(), poly.begin(), poly.end());
-    }
-    cell_start.push_back(cells.size());
+    cells_t c = cells(bsp);
+    std::vector<id_t> const& empty_ids = c.leaf_ids;
+    std::vector<size_t> const& cell_start = c.cell_start;
+    std::vector<bsp_node_t> const& cells = c.edges;
 
     // get centerpoints
     std::vector<nav_node_t> nodes(n_leaves, {{0.f, 0.f}, 0, 0});
-    for (size_t i=0; i<empty_ids.size(); i++) {
-        vec2_t acc = {0.f, 0.f};
+    for (size_t i=0; i<empty_ids.size(); i++)
+        nodes[empty_ids[i]].position = c.centers[i];
+
+    // bucket cell edges by the node plane they lie on, sorted along the plane
+    struct tagged_edge_t {
+        size_t plane;
+        float tmin, tmax;
+        id_t leaf;
+    };
+
+    std::vector<tagged_edge_t> edges;
+    edges.reserve(cells.size());
+    for (id_t i=0; i<empty_ids.size(); i++) {
         for (size_t j=cell_start[i]; j<cell_start[i+1]; j++) {
-            bsp_node_t const& n = cells[j];
-            acc = acc + n.plane.apply().p;
+            paramline_t const& pl = cells[j].plane;
+            edges.push_back({(size_t) pl.line.userdata, std::min(pl.t1, pl.t2), std::max(pl.t1, pl.t2), empty_ids[i]});
         }
-        acc = acc / (cell_start[i+1] - cell_start[i]);
-        nodes[empty_ids[i]].position = std::move(acc);
-    }
-
-    // identify links and create portals
-    std::vector<std::pair<id_t, paramline_t>> tagged_planes;
-    tagged_planes.reserve(cells.size());
-    for (id_t i=0; i<empty_ids.size(); i++) {
-        for (size_t j=cell_start[i]; j<cell_start[i+1]; j++)
-            tagged_planes.push_back(std::make_pair(empty_ids[i], cells[j].plane));
     }
+    std::sort(edges.begin(), edges.end(), [](tagged_edge_t const& a, tagged_edge_t const& b) {
+        return (a.plane < b.plane) || (a.plane == b.plane && a.tmin < b.tmin);
+    });
 
+    // sweep each bucket, edges that overlap by more than eps are neighbors
+    constexpr float eps = 1e-4;
     std::vector<std::pair<id_t, nav_link_t>> tagged_links;
-    for (id_t i=0; i<tagged_planes.size(); i++) {
-        for (id_t j=i+1; j<tagged_planes.size(); j++) {
-            
-            paramline_t a, b;
-            a = tagged_planes[i].second;
-            b = tagged_planes[j].second;
-
-            if (a.line.userdata == b.line.userdata) {
-                // same hyperplane => neighbors if overlap
-                id_t a_lid, b_lid;
-                a_lid = tagged_planes[i].first;
-                b_lid = tagged_planes[j].first;
-
-                float a_tmin, a_tmax, b_tmin, b_tmax;
-                a_tmin = std::min(a.t1, a.t2);
-                a_tmax = std::max(a.t1, a.t2);
-                b_tmin = std::min(b.t1, b.t2);
-                b_tmax = std::max(b.t1, b.t2);
-
-                paramline_t portal = a.line;
-
-                bool b_overlap = false;
-                if ((b_overlap |= a_tmin <= b_tmin && b_tmin < a_tmax)) {
-                    portal.t1 = b_tmin;
-                } else if ((b_overlap |= b_tmin <= a_tmin && a_tmin < b_tmax)) {
-                    portal.t1 = a_tmin;
-                }
-                portal.t2 = std::min(a_tmax, b_tmax);
-
-                float eps = 1e-4;
-                if (b_overlap && fabsf(portal.t1 - portal.t2) > eps) {
-                    tagged_links.push_back({a_lid, {b_lid, portal.apply(), 0.f}});
-                    tagged_links.push_back({b_lid, {a_lid, portal.flip().apply(), 0.f}});
-                }
-            }
+    std::vector<size_t> active; // edges of the bucket that reach past the current tmin
+    for (size_t i=0; i<edges.size(); i++) {
+        tagged_edge_t const& b = edges[i];
+        if (0 == i || edges[i-1].plane != b.plane) active.clear();
+
+        std::erase_if(active, [&](size_t k) { return edges[k].tmax - b.tmin <= eps; });
+        for (size_t k : active) {
+            tagged_edge_t const& a = edges[k];
+            paramline_t portal = bsp[a.plane].plane.line;
+            portal.line.userdata = (void *) a.plane;
+            portal.t1 = b.tmin;
+            portal.t2 = std::min(a.tmax, b.tmax);
+            if (portal.t2 - portal.t1 <= eps) continue;
+
+            // funnel() wants portal.p on the left going from a to b, which
+            // runs against the line when a is on its left side
+            if (bsp.planes[a.plane].is_left(nodes[a.leaf].position)) portal.flip();
+            tagged_links.push_back({a.leaf, {b.leaf, portal.apply(), 0.f}});
+            tagged_links.push_back({b.leaf, {a.leaf, portal.flip().apply(), 0.f}});
         }
+        active.push_back(i);
     }
 
-    // sort links using tags
-    std::sort(tagged_links.begin(), tagged_links.end(), [](auto a, auto b){
-        return (a.first < b.first);
-    });
-
-    // point node ranges to sorted links
-    for (id_t id : empty_ids) {
-        auto cond = [id](auto a){ return (a.first == id); };
-        auto start = std::find_if(tagged_links.begin(), tagged_links.end(), cond);
-        nodes[id].links_start = std::distance(tagged_links.begin(), start);
-        auto end = std::find_if_not(start, tagged_links.end(), cond);
-        nodes[id].links_end = std::distance(tagged_links.begin(), end);
+    // group links by source in one counting pass, which also gives the node ranges
+    for (auto const& tagged_link : tagged_links) nodes[tagged_link.first].links_end++;
+    size_t acc = 0;
+    for (nav_node_t &n : nodes) {
+        n.links_start = acc;
+        acc += n.links_end;
+        n.links_end = n.links_start;
     }
 
-    // discard tags
-    std::vector<nav_link_t> links;
-    links.reserve(tagged_links.size());
-    for (auto tagged_link : tagged_links) links.push_back(tagged_link.second);
+    std::vector<nav_link_t> links(tagged_links.size());
+    for (auto const& tagged_link : tagged_links) links[nodes[tagged_link.first].links_end++] = tagged_link.second;
 
     // set weights to euclidean distance
     for (nav_node_t const& n : nodes) {
@@ -219,97 +271,280 @@ navmesh_t build(bsp_t const& bsp) {
     return navmesh;
 }
 
+// serialized layout, all fields little-endian:
+//   header : u32 magic, u32 version, u32 node count, u32 link count
+//   nodes  : node count * (f32 x, y, u32 links_start, links_end)
+//   links  : link count * (u32 target, u32 portal node, f32 px, py, qx, qy, weight)
+// the portal node is the userdata of the portal line, see build()
+constexpr uint32_t NAV_FORMAT_MAGIC = 0x56414e41; // "ANAV"
+constexpr uint32_t NAV_FORMAT_VERSION = 1;
+constexpr size_t NAV_HEADER_SIZE = 16;
+constexpr size_t NAV_NODE_SIZE = 16;
+constexpr size_t NAV_LINK_SIZE = 28;
+
+std::vector<uint8_t> serialize(navmesh_t const& navmesh) {
+    std::vector<uint8_t> out;
+    out.reserve(NAV_HEADER_SIZE + navmesh.nodes.size() * NAV_NODE_SIZE + navmesh.links.size() * NAV_LINK_SIZE);
+
+    auto put_u32 = [&](uint32_t v) { for (int i=0; i<4; i++) out.push_back((v >> (8 * i)) & 0xff); };
+    auto put_f32 = [&](float v) { put_u32(std::bit_cast<uint32_t>(v)); };
+
+    put_u32(NAV_FORMAT_MAGIC);
+    put_u32(NAV_FORMAT_VERSION);
+    put_u32(navmesh.nodes.size());
+    put_u32(navmesh.links.size());
+
+    for (nav_node_t const& n : navmesh.nodes) {
+        put_f32(n.position.x);
+        put_f32(n.position.y);
+        put_u32(n.links_start);
+        put_u32(n.links_end);
+    }
+
+    for (nav_link_t const& link : navmesh.links) {
+        put_u32(link.target);
+        put_u32((size_t) link.portal.userdata);
+        put_f32(link.portal.p.x);
+        put_f32(link.portal.p.y);
+        put_f32(link.portal.q.x);
+        put_f32(link.portal.q.y);
+        put_f32(link.weight);
+    }
+
+    return out;
+}
+
+// a buffer with a bad header, size, link range or link target gives an empty navmesh
+navmesh_t deserialize(uint8_t const* data, size_t len) {
+    auto get_u32 = [&](size_t off) {
+        return (uint32_t)data[off] | ((uint32_t)data[off+1] << 8) | ((uint32_t)data[off+2] << 16) | ((uint32_t)data[off+3] << 24);
+    };
+    auto get_f32 = [&](size_t off) { return std::bit_cast<float>(get_u32(off)); };
+
+    bool b_valid = len >= NAV_HEADER_SIZE && NAV_FORMAT_MAGIC == get_u32(0) && NAV_FORMAT_VERSION == get_u32(4);
+    size_t n_nodes = b_valid ? get_u32(8) : 0;
+    size_t n_links = b_valid ? get_u32(12) : 0;
+    b_valid = b_valid && (len - NAV_HEADER_SIZE) >= n_nodes * NAV_NODE_SIZE + n_links * NAV_LINK_SIZE;
+    if (!b_valid) return {};
+
+    navmesh_t out;
+    out.nodes.resize(n_nodes);
+    out.links.resize(n_links);
+
+    size_t off = NAV_HEADER_SIZE;
+    for (nav_node_t &n : out.nodes) {
+        n.position = {get_f32(off), get_f32(off + 4)};
+        n.links_start = get_u32(off + 8);
+        n.links_end = get_u32(off + 12);
+        if (n.links_start > n.links_end || n.links_end > n_links) return {}; // queries walk these ranges
+        off += NAV_NODE_SIZE;
+    }
+
+    for (nav_link_t &link : out.links) {
+        link.target = get_u32(off);
+        if (link.target >= n_nodes) return {};
+        link.portal = {{get_f32(off + 8), get_f32(off + 12)}, {get_f32(off + 16), get_f32(off + 20)}, (void *)(size_t) get_u32(off + 4)};
+        link.weight = get_f32(off + 24);
+        off += NAV_LINK_SIZE;
+    }
+
+    return out;
+}
+
 using path_t = typename std::vector<size_t>;
 
-path_t astar(bsp_t const& bsp, navmesh_t const& navmesh, vec2_t start, vec2_t goal) {
+// binary min-heap of node ids keyed by float cost, pos allows decrease-key.
+// per-node state is only valid where stamp matches the generation, so reset
+// is O(1) once the arrays have their size
+struct node_heap_t {
+    static constexpr uint32_t NOT_QUEUED = 0xffffffff;
+    static constexpr uint32_t CLOSED = 0xfffffffe;
+
+    std::vector<uint32_t> heap;
+    std::vector<uint32_t> pos; // index in heap, or one of the states above
+    std::vector<float> key;
+    std::vector<uint32_t> stamp;
+    uint32_t generation = 0;
+
+    void reset(size_t n) {
+        heap.clear();
+        if (stamp.size() != n || 0 == ++generation) { // resized or wrapped around
+            stamp.assign(n, 0);
+            pos.resize(n);
+            key.resize(n);
+            generation = 1;
+        }
+    }
+
+    bool empty() const { return heap.empty(); }
+    bool touched(uint32_t node) const { return generation == stamp[node]; }
+    bool closed(uint32_t node) const { return touched(node) && CLOSED == pos[node]; }
+
+    // insert node, or lower its key if it is queued with a higher one
+    void push(uint32_t node, float k) {
+        assert(!closed(node));
+        if (!touched(node)) {
+            stamp[node] = generation;
+            pos[node] = heap.size();
+            heap.push_back(node);
+        } else if (k >= key[node]) {
+            return;
+        }
+        key[node] = k;
+        sift_up(pos[node]);
+    }
+
+    // remove the node with the lowest key and mark it closed
+    uint32_t pop() {
+        uint32_t top = heap.front();
+        pos[top] = CLOSED;
+        uint32_t last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            heap[0] = last;
+            pos[last] = 0;
+            sift_down(0);
+        }
+        return top;
+    }
+
+    void sift_up(size_t i) {
+        uint32_t node = heap[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / 2;
+            if (!(key[node] < key[heap[parent]])) break;
+            heap[i] = heap[parent];
+            pos[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = node;
+        pos[node] = i;
+    }
+
+    void sift_down(size_t i) {
+        uint32_t node = heap[i];
+        for (;;) {
+            size_t child = 2 * i + 1;
+            if (child >= heap.size()) break;
+            if (child + 1 < heap.size() && key[heap[child + 1]] < key[heap[child]]) child++;
+            if (!(key[heap[child]] < key[node])) break;
+            heap[i] = heap[child];
+            pos[heap[i]] = i;
+            i = child;
+        }
+        heap[i] = node;
+        pos[node] = i;
+    }
+};
+
+// scratch buffers for path queries, keep one per thread to avoid allocations
+struct path_query_context_t {
+    node_heap_t queue; // its stamps also tell which dists and prev are set
+    std::vector<float> dists;
+    std::vector<uint32_t> prev;
+    path_t path;
+    std::vector<line_t> portals;
+
+    // hierarchical queries, see hpa_t
+    node_heap_t abstract_queue;
+    std::vector<float> abstract_dists;
+    std::vector<uint32_t> abstract_prev;
+    std::vector<uint32_t> abstract_edge; // edge taken into the node, NULL_ID from the virtual start
+    std::vector<uint32_t> route;
+};
+
+// cells from the leaf of start to the leaf of goal, empty if there is no route
+void astar(bsp_t const& bsp, navmesh_t const& navmesh, vec2_t start, vec2_t goal, path_query_context_t &ctx, path_t &out) {
 
     const id_t src = leaf_id(bsp, 0, start);
     const id_t dest = leaf_id(bsp, 0, goal);
 
-    // use sorting to create priority queue
     size_t len = navmesh.nodes.size();
     assert(src < len);
     assert(dest < len);
 
-    std::vector<uint16_t> dists(len, 0xffff);
-    std::vector<uint16_t> prev(len, 0xffff);
-    std::vector<uint32_t> queue;
-    queue.reserve(len);
-    queue.push_back(0xffff0000 | src); // high bytes are bitflipped distance,
-                                       // low bytes are node offset
+    // open list keyed by cost so far plus distance from the cell to the goal
+    node_heap_t &queue = ctx.queue;
+    queue.reset(len);
+    ctx.dists.resize(len);
+    ctx.prev.resize(len);
+
+    ctx.dists[src] = 0.f;
+    ctx.prev[src] = NULL_ID;
+    queue.push(src, dist(navmesh.nodes[src].position, goal));
     bool b_found = false;
 
     while (!queue.empty()) {
-        std::sort(queue.begin(), queue.end());
-        uint16_t ui = queue.back() & 0x0000ffff;
-        
-        assert(0xffff != ui);
+        uint32_t ui = queue.pop();
         if ((b_found |= dest == ui))
             break;
-        
-        uint16_t ud = ~(queue.back() & 0xffff0000) >> 16;
-        queue.pop_back();
-        
+
         nav_node_t const& n = navmesh.nodes[ui];
         for (size_t i=n.links_start; i<n.links_end; i++) {
             nav_link_t const& link = navmesh.links[i];
-            uint16_t vi = link.target;
+            uint32_t vi = link.target;
             assert(ui != vi);
+            if (queue.closed(vi)) continue;
 
-            uint16_t alt;
-            float d = dist(navmesh.nodes[link.target].position, goal); // a* heuristic
-            assert(0xffff - ud > (uint16_t)((link.weight + d) * 10.f));
-            alt = ud + (uint16_t)((link.weight + d) * 10.f);
-
-            if (alt < dists[vi]) {
-                dists[vi] = alt;
-                prev[vi] = ui;
-                queue.push_back((~alt << 16) | vi);
+            float alt = ctx.dists[ui] + link.weight;
+            if (!queue.touched(vi) || alt < ctx.dists[vi]) {
+                ctx.dists[vi] = alt;
+                ctx.prev[vi] = ui;
+                queue.push(vi, alt + dist(navmesh.nodes[vi].position, goal)); // a* heuristic
             }
         }
     }
 
     // unroll prev
-    std::vector<size_t> path;
+    out.clear();
     if (b_found) {
         size_t id = dest;
         for(;;) {
-            path.push_back(id);
+            out.push_back(id);
             if (id == src) break;
-            id = prev[id];
+            id = ctx.prev[id];
         }
     }
-    std::reverse(path.begin(), path.end());
+    std::reverse(out.begin(), out.end());
+}
 
+path_t astar(bsp_t const& bsp, navmesh_t const& navmesh, vec2_t start, vec2_t goal) {
+    path_query_context_t ctx;
+    path_t path;
+    astar(bsp, navmesh, start, goal, ctx, path);
     return path;
 }
 
-std::vector<vec2_t> funnel(std::vector<line_t> portals, vec2_t start, vec2_t goal) {
+// string pulling through the portals, out starts with start and ends with goal
+void funnel(std::vector<line_t> const& portals, vec2_t start, vec2_t goal, std::vector<vec2_t> &out) {
     assert(!portals.empty());
 
+    // the goal acts as a last portal of zero width
+    line_t const goal_portal = {goal, goal};
+    size_t n_portals = portals.size() + 1;
+    auto portal = [&](size_t i) -> line_t const& { return (i < portals.size()) ? portals[i] : goal_portal; };
+
     vec2_t apex = start;
     vec2_t p = portals[0].p; // left
     vec2_t q = portals[0].q; // right
 
-    portals.push_back({goal, goal});
-
-    std::vector<vec2_t> out;
+    out.clear();
     out.push_back(apex);
 
     size_t li=0, ri=0;
 
-    for (size_t i=1; i<portals.size(); i++) {
-        assert(out.size() <= portals.size() + 2);
+    for (size_t i=1; i<n_portals; i++) {
+        assert(out.size() <= n_portals + 2);
 
-        vec2_t p2 = portals[i].p;
+        vec2_t p2 = portal(i).p;
 
         if (cross(q - apex, p2 - apex) > 0.f) { // p2 right of q
             out.push_back(q);
             apex = q;
             li = ri;
             i = ri;
-            p = portals[ri+1].p;
-            q = portals[ri+1].q;
+            p = portal(ri+1).p;
+            q = portal(ri+1).q;
             continue;
         }
 
@@ -318,15 +553,15 @@ std::vector<vec2_t> funnel(std::vector<line_t> portals, vec2_t start, vec2_t goa
             li = i;
         }
 
-        vec2_t q2 = portals[i].q;
+        vec2_t q2 = portal(i).q;
 
         if (cross(p - apex, q2 - apex) < 0.f) { // q2 left of p
             out.push_back(p);
             apex = p;
             ri = li;
             i = li;
-            p = portals[li+1].p;
-            q = portals[li+1].q;
+            p = portal(li+1).p;
+            q = portal(li+1).q;
             continue;
         }
 
@@ -337,37 +572,540 @@ std::vector<vec2_t> funnel(std::vector<line_t> portals, vec2_t start, vec2_t goa
     }
 
     out.push_back(goal);
+}
 
+std::vector<vec2_t> funnel(std::vector<line_t> const& portals, vec2_t start, vec2_t goal) {
+    std::vector<vec2_t> out;
+    funnel(portals, start, goal, out);
     return out;
 }
 
-std::vector<vec2_t> find_path(bsp_t const& bsp, navmesh_t const& navmesh, vec2_t start, vec2_t goal) {
+// funnel through the portals along ctx.path, false and an empty out if it is empty
+bool path_waypoints(navmesh_t const& navmesh, vec2_t start, vec2_t goal, path_query_context_t &ctx, std::vector<vec2_t> &out) {
+    if (ctx.path.empty()) {
+        out.clear();
+        return false;
+    }
+
+    // get portals along path
+    ctx.portals.clear();
+    for(size_t i=0; i+1<ctx.path.size(); i++) {
+        size_t li = navmesh.nodes[ctx.path[i]].links_start;
+        while (ctx.path[i+1] != navmesh.links[li].target) li++;
+        ctx.portals.push_back(navmesh.links[li].portal);
+    }
+
+    funnel(ctx.portals, start, goal, out);
+    return true;
+}
+
+// waypoints from start to goal, false and an empty out if there is no route
+bool find_path(bsp_t const& bsp, navmesh_t const& navmesh, vec2_t start, vec2_t goal, path_query_context_t &ctx, std::vector<vec2_t> &out) {
 
     id_t start_id = leaf_id(bsp, 0, start);
     id_t goal_id = leaf_id(bsp, 0, goal);
 
     // attempt to short-circuit
-    if (start_id == goal_id) return {start, goal};
-
     vec2_t v;
     line_t l;
-    if (!sweep(bsp, {start, goal}, v, l)) {
-        return {start, goal};
+    if (start_id == goal_id || !sweep(bsp, {start, goal}, v, l)) {
+        out.assign({start, goal});
+        return true;
     }
 
     // compute path
-    path_t path = astar(bsp, navmesh, start, goal);
+    astar(bsp, navmesh, start, goal, ctx, ctx.path);
+    return path_waypoints(navmesh, start, goal, ctx, out);
+}
 
-    // get portals along path
-    std::vector<line_t> portals;
-    portals.reserve(path.size() - 1);
-    for(size_t i=0; i<path.size()-1; i++) {
-        size_t li = navmesh.nodes[path[i]].links_start;
-        while (path[i+1] != navmesh.links[li].target) li++;
-        portals.push_back(navmesh.links[li].portal);
+std::vector<vec2_t> find_path(bsp_t const& bsp, navmesh_t const& navmesh, vec2_t start, vec2_t goal) {
+    path_query_context_t ctx;
+    std::vector<vec2_t> out;
+    find_path(bsp, navmesh, start, goal, ctx, out);
+    return out;
+}
+
+// abstract graph for long queries. cells are grouped into clusters (a grid over the
+// cell centers, split into connected parts), neighboring clusters are joined through
+// their widest link and a few more on long borders. the cells of these links are the
+// entrances (abstract nodes), the entrances of a cluster are joined by their shortest
+// route inside it. routes are near optimal, not exact
+struct hpa_edge_t {
+    uint32_t target; // abstract node
+    float weight;
+    uint32_t path_start, path_end; // cells after the source up to the target, in hpa_t::paths
+};
+
+struct hpa_hop_t {
+    float dist; // shortest route inside the cluster
+    uint32_t next; // next cell on it, NULL_ID at the entrance
+};
+
+struct hpa_t {
+    std::vector<uint32_t> cluster; // cluster of each navmesh node
+    std::vector<uint32_t> entrance_start; // abstract nodes of cluster c are [entrance_start[c], entrance_start[c+1])
+    std::vector<uint32_t> entrances; // navmesh node of each abstract node
+    std::vector<uint32_t> edge_start; // edges of abstract node i are [edge_start[i], edge_start[i+1])
+    std::vector<hpa_edge_t> edges;
+    std::vector<uint32_t> paths;
+
+    // routes from every cell to the entrances of its cluster, so that queries need
+    // no search inside the clusters of start and goal
+    std::vector<uint32_t> local; // index of each navmesh node within its cluster
+    std::vector<size_t> hop_start; // hops of cluster c start at hop_start[c], one row per cell
+    std::vector<hpa_hop_t> hops;
+
+    // from cell to abstract node e, both in the same cluster
+    hpa_hop_t const& hop(uint32_t cell, uint32_t e) const {
+        uint32_t c = cluster[cell];
+        assert(e >= entrance_start[c] && e < entrance_start[c + 1]);
+        return hops[hop_start[c] + (size_t) local[cell] * (entrance_start[c + 1] - entrance_start[c]) + (e - entrance_start[c])];
     }
+};
+
+// dijkstra from src over the cells of its cluster
+void cluster_dijkstra(navmesh_t const& navmesh, hpa_t const& hpa, uint32_t src, node_heap_t &queue, std::vector<float> &dists, std::vector<uint32_t> &prev) {
+    size_t len = navmesh.nodes.size();
+    queue.reset(len);
+    dists.resize(len);
+    prev.resize(len);
+
+    uint32_t c = hpa.cluster[src];
+    dists[src] = 0.f;
+    prev[src] = NULL_ID;
+    queue.push(src, 0.f);
 
-    return funnel(portals, start, goal);
+    while (!queue.empty()) {
+        uint32_t ui = queue.pop();
+        nav_node_t const& n = navmesh.nodes[ui];
+        for (size_t i=n.links_start; i<n.links_end; i++) {
+            nav_link_t const& link = navmesh.links[i];
+            uint32_t vi = link.target;
+            if (c != hpa.cluster[vi] || queue.closed(vi)) continue;
+
+            float alt = dists[ui] + link.weight;
+            if (!queue.touched(vi) || alt < dists[vi]) {
+                dists[vi] = alt;
+                prev[vi] = ui;
+                queue.push(vi, alt);
+            }
+        }
+    }
+}
+
+// cluster_cells is the average number of cells per grid square before the split
+hpa_t build_hpa(navmesh_t const& navmesh, uint32_t cluster_cells = 512) {
+    static constexpr float inf = std::numeric_limits<float>::infinity();
+    assert(cluster_cells > 0);
+
+    hpa_t hpa;
+    size_t len = navmesh.nodes.size();
+    hpa.cluster.assign(len, NULL_ID);
+
+    // grid over the centers of cells with links, solid leaves have none
+    vec2_t min = {inf, inf}, max = {-inf, -inf};
+    size_t n_linked = 0;
+    for (nav_node_t const& n : navmesh.nodes) {
+        if (n.links_start == n.links_end) continue;
+        min.x = std::min(min.x, n.position.x);
+        min.y = std::min(min.y, n.position.y);
+        max.x = std::max(max.x, n.position.x);
+        max.y = std::max(max.y, n.position.y);
+        n_linked++;
+    }
+    float area = std::max((max.x - min.x) * (max.y - min.y), 1e-6f);
+    float side = n_linked ? std::sqrt(area * cluster_cells / n_linked) : 1.f;
+    auto square = [&](vec2_t p) -> int64_t {
+        int64_t gx = (int64_t) ((p.x - min.x) / side);
+        int64_t gy = (int64_t) ((p.y - min.y) / side);
+        return (gy << 32) ^ gx;
+    };
+
+    // clusters are the connected parts of each square
+    uint32_t n_clusters = 0;
+    std::vector<uint32_t> stack;
+    for (uint32_t i=0; i<len; i++) {
+        if (NULL_ID != hpa.cluster[i]) continue;
+        int64_t sq = square(navmesh.nodes[i].position);
+        hpa.cluster[i] = n_clusters;
+        stack.push_back(i);
+        while (!stack.empty()) {
+            nav_node_t const& n = navmesh.nodes[stack.back()];
+            stack.pop_back();
+            for (size_t li=n.links_start; li<n.links_end; li++) {
+                uint32_t vi = navmesh.links[li].target;
+                if (NULL_ID != hpa.cluster[vi] || sq != square(navmesh.nodes[vi].position)) continue;
+                hpa.cluster[vi] = n_clusters;
+                stack.push_back(vi);
+            }
+        }
+        n_clusters++;
+    }
+
+    // widest link between each pair of neighboring clusters
+    struct crossing_t {
+        uint32_t ca, cb; // ca < cb
+        float width;
+        uint32_t a, b;
+    };
+    std::vector<crossing_t> crossings;
+    for (uint32_t i=0; i<len; i++) {
+        nav_node_t const& n = navmesh.nodes[i];
+        for (size_t li=n.links_start; li<n.links_end; li++) {
+            nav_link_t const& link = navmesh.links[li];
+            uint32_t ca = hpa.cluster[i], cb = hpa.cluster[link.target];
+            if (ca < cb) crossings.push_back({ca, cb, dist(link.portal.p, link.portal.q), i, (uint32_t) link.target});
+        }
+    }
+    std::sort(crossings.begin(), crossings.end(), [](crossing_t const& x, crossing_t const& y) {
+        if (x.ca != y.ca) return x.ca < y.ca;
+        if (x.cb != y.cb) return x.cb < y.cb;
+        return x.width > y.width;
+    });
+    // keep the widest crossing of each pair, and on long borders the ones at least half
+    // the border away from the kept ones
+    auto mid = [&](crossing_t const& x) { return (navmesh.nodes[x.a].position + navmesh.nodes[x.b].position) * 0.5f; };
+    size_t n_kept = 0;
+    for (size_t i=0, j; i<crossings.size(); i=j) {
+        float extent = 0.f;
+        for (j=i; j<crossings.size() && crossings[j].ca == crossings[i].ca && crossings[j].cb == crossings[i].cb; j++)
+            extent = std::max(extent, dist(mid(crossings[i]), mid(crossings[j])));
+
+        size_t pair_start = n_kept;
+        for (size_t k=i; k<j; k++) {
+            bool b_far = true;
+            for (size_t m=pair_start; m<n_kept && b_far; m++) b_far = dist(mid(crossings[k]), mid(crossings[m])) > extent * 0.5f;
+            if (b_far) crossings[n_kept++] = crossings[k];
+        }
+    }
+    crossings.resize(n_kept);
+
+    // abstract nodes grouped by cluster
+    std::vector<uint32_t> abstract_id(len, NULL_ID);
+    for (crossing_t const& x : crossings) abstract_id[x.a] = abstract_id[x.b] = 0;
+    hpa.entrance_start.assign(n_clusters + 1, 0);
+    for (uint32_t i=0; i<len; i++)
+        if (NULL_ID != abstract_id[i]) hpa.entrance_start[hpa.cluster[i] + 1]++;
+    for (uint32_t c=0; c<n_clusters; c++) hpa.entrance_start[c + 1] += hpa.entrance_start[c];
+    hpa.entrances.resize(hpa.entrance_start.back());
+    std::vector<uint32_t> fill(hpa.entrance_start.begin(), hpa.entrance_start.end() - 1);
+    for (uint32_t i=0; i<len; i++) {
+        if (NULL_ID == abstract_id[i]) continue;
+        abstract_id[i] = fill[hpa.cluster[i]]++;
+        hpa.entrances[abstract_id[i]] = i;
+    }
+
+    // edges, through the crossing links and between entrances of the same cluster
+    std::vector<std::pair<uint32_t, hpa_edge_t>> tagged_edges;
+    for (crossing_t const& x : crossings) {
+        float w = dist(navmesh.nodes[x.a].position, navmesh.nodes[x.b].position);
+        uint32_t k = hpa.paths.size();
+        hpa.paths.push_back(x.b);
+        hpa.paths.push_back(x.a);
+        tagged_edges.push_back({abstract_id[x.a], {abstract_id[x.b], w, k, k + 1}});
+        tagged_edges.push_back({abstract_id[x.b], {abstract_id[x.a], w, k + 1, k + 2}});
+    }
+
+    // cells grouped by cluster, and a table row per cell
+    std::vector<uint32_t> member_start(n_clusters + 1, 0);
+    hpa.local.resize(len);
+    for (uint32_t i=0; i<len; i++) hpa.local[i] = member_start[hpa.cluster[i] + 1]++;
+    hpa.hop_start.assign(n_clusters + 1, 0);
+    for (uint32_t c=0; c<n_clusters; c++) {
+        size_t n_entrances = hpa.entrance_start[c + 1] - hpa.entrance_start[c];
+        hpa.hop_start[c + 1] = hpa.hop_start[c] + member_start[c + 1] * n_entrances;
+        member_start[c + 1] += member_start[c];
+    }
+    std::vector<uint32_t> members(len);
+    for (uint32_t i=0; i<len; i++) members[member_start[hpa.cluster[i]] + hpa.local[i]] = i;
+    hpa.hops.resize(hpa.hop_start.back());
+
+    node_heap_t queue;
+    std::vector<float> dists;
+    std::vector<uint32_t> prev;
+    for (uint32_t c=0; c<n_clusters; c++) {
+        uint32_t n_entrances = hpa.entrance_start[c + 1] - hpa.entrance_start[c];
+        for (uint32_t e=hpa.entrance_start[c]; e<hpa.entrance_start[c + 1]; e++) {
+            cluster_dijkstra(navmesh, hpa, hpa.entrances[e], queue, dists, prev);
+
+            // clusters are connected, every cell was reached and prev leads to e
+            for (uint32_t m=member_start[c]; m<member_start[c + 1]; m++) {
+                uint32_t cell = members[m];
+                assert(queue.touched(cell));
+                hpa.hops[hpa.hop_start[c] + (size_t) hpa.local[cell] * n_entrances + (e - hpa.entrance_start[c])] = {dists[cell], prev[cell]};
+            }
+
+            for (uint32_t f=hpa.entrance_start[c]; f<hpa.entrance_start[c + 1]; f++) {
+                if (e == f) continue;
+                uint32_t k = hpa.paths.size();
+                for (uint32_t id=hpa.entrances[f]; NULL_ID != prev[id]; id=prev[id]) hpa.paths.push_back(id);
+                std::reverse(hpa.paths.begin() + k, hpa.paths.end());
+                tagged_edges.push_back({e, {f, dists[hpa.entrances[f]], k, (uint32_t) hpa.paths.size()}});
+            }
+        }
+    }
+
+    // group edges by source in one counting pass
+    size_t n_abstract = hpa.entrances.size();
+    hpa.edge_start.assign(n_abstract + 1, 0);
+    for (auto const& tagged_edge : tagged_edges) hpa.edge_start[tagged_edge.first + 1]++;
+    for (size_t i=0; i<n_abstract; i++) hpa.edge_start[i + 1] += hpa.edge_start[i];
+    hpa.edges.resize(tagged_edges.size());
+    fill.assign(hpa.edge_start.begin(), hpa.edge_start.end() - 1);
+    for (auto const& tagged_edge : tagged_edges) hpa.edges[fill[tagged_edge.first]++] = tagged_edge.second;
+
+    return hpa;
+}
+
+// cells from the leaf of start to the leaf of goal through the abstract graph, empty
+// if there is no route. start and goal join it through their own cluster's entrances
+void hpa_route(bsp_t const& bsp, navmesh_t const& navmesh, hpa_t const& hpa, vec2_t start, vec2_t goal, path_query_context_t &ctx, path_t &out) {
+
+    const id_t src = leaf_id(bsp, 0, start);
+    const id_t dest = leaf_id(bsp, 0, goal);
+    assert(src < navmesh.nodes.size());
+    assert(dest < navmesh.nodes.size());
+
+    // in the same or neighboring clusters the plain search is short, and the abstract
+    // graph would only add detours through entrances
+    uint32_t cs = hpa.cluster[src], cg = hpa.cluster[dest];
+    bool b_near = (cs == cg);
+    for (uint32_t e=hpa.entrance_start[cs]; e<hpa.entrance_start[cs + 1] && !b_near; e++)
+        for (uint32_t i=hpa.edge_start[e]; i<hpa.edge_start[e + 1] && !b_near; i++)
+            b_near = (cg == hpa.cluster[hpa.entrances[hpa.edges[i].target]]);
+    if (b_near) {
+        astar(bsp, navmesh, start, goal, ctx, out);
+        return;
+    }
+
+    // a* over the entrances, with a virtual start and goal at the end
+    const uint32_t n_abstract = hpa.entrances.size();
+    const uint32_t vs = n_abstract, vg = n_abstract + 1;
+    node_heap_t &queue = ctx.abstract_queue;
+    queue.reset(n_abstract + 2);
+    ctx.abstract_dists.resize(n_abstract + 2);
+    ctx.abstract_prev.resize(n_abstract + 2);
+    ctx.abstract_edge.resize(n_abstract + 2);
+
+    auto relax = [&](uint32_t ui, uint32_t vi, float alt, uint32_t edge) {
+        if (queue.closed(vi)) return;
+        if (!queue.touched(vi) || alt < ctx.abstract_dists[vi]) {
+            ctx.abstract_dists[vi] = alt;
+            ctx.abstract_prev[vi] = ui;
+            ctx.abstract_edge[vi] = edge;
+            float h = (vg == vi) ? 0.f : dist(navmesh.nodes[hpa.entrances[vi]].position, goal);
+            queue.push(vi, alt + h);
+        }
+    };
+
+    ctx.abstract_dists[vs] = 0.f;
+    queue.push(vs, 0.f);
+    bool b_found = false;
+
+    while (!queue.empty()) {
+        uint32_t ui = queue.pop();
+        if ((b_found |= vg == ui))
+            break;
+
+        if (vs == ui) {
+            for (uint32_t e=hpa.entrance_start[cs]; e<hpa.entrance_start[cs + 1]; e++)
+                relax(vs, e, hpa.hop(src, e).dist, NULL_ID);
+            continue;
+        }
+
+        for (uint32_t i=hpa.edge_start[ui]; i<hpa.edge_start[ui + 1]; i++)
+            relax(ui, hpa.edges[i].target, ctx.abstract_dists[ui] + hpa.edges[i].weight, i);
+        if (cg == hpa.cluster[hpa.entrances[ui]])
+            relax(ui, vg, ctx.abstract_dists[ui] + hpa.hop(dest, ui).dist, NULL_ID);
+    }
+
+    out.clear();
+    if (!b_found) return;
+
+    // entrances along the route
+    ctx.route.clear();
+    for (uint32_t id=ctx.abstract_prev[vg]; vs != id; id=ctx.abstract_prev[id]) ctx.route.push_back(id);
+    std::reverse(ctx.route.begin(), ctx.route.end());
+
+    // refine, src to the first entrance, the stored edge paths, the last entrance to dest
+    uint32_t first = ctx.route.front(), last = ctx.route.back();
+    for (uint32_t id=src; NULL_ID != id; id=hpa.hop(id, first).next) out.push_back(id);
+    for (size_t i=1; i<ctx.route.size(); i++) {
+        hpa_edge_t const& edge = hpa.edges[ctx.abstract_edge[ctx.route[i]]];
+        out.insert(out.end(), hpa.paths.begin() + edge.path_start, hpa.paths.begin() + edge.path_end);
+    }
+    size_t k = out.size();
+    for (uint32_t id=dest; NULL_ID != hpa.hop(id, last).next; id=hpa.hop(id, last).next) out.push_back(id);
+    std::reverse(out.begin() + k, out.end());
+}
+
+// find_path() through the abstract graph
+bool find_path(bsp_t const& bsp, navmesh_t const& navmesh, hpa_t const& hpa, vec2_t start, vec2_t goal, path_query_context_t &ctx, std::vector<vec2_t> &out) {
+
+    id_t start_id = leaf_id(bsp, 0, start);
+    id_t goal_id = leaf_id(bsp, 0, goal);
+
+    // attempt to short-circuit
+    vec2_t v;
+    line_t l;
+    if (start_id == goal_id || !sweep(bsp, {start, goal}, v, l)) {
+        out.assign({start, goal});
+        return true;
+    }
+
+    hpa_route(bsp, navmesh, hpa, start, goal, ctx, ctx.path);
+    return path_waypoints(navmesh, start, goal, ctx, out);
+}
+
+struct path_query_t {
+    vec2_t start, goal;
+};
+
+struct path_query_stats_t {
+    bool found;
+    uint32_t cells; // corridor length, 0 when start sees goal
+    uint32_t waypoints;
+    float micros; // wall time of the query
+};
+
+// results and scratch of find_paths(), reuse it across batches to avoid allocations
+struct path_batch_t {
+    std::vector<path_query_context_t> contexts; // one per pool thread
+    std::vector<std::vector<vec2_t>> paths; // matches the queries, empty if there is no route
+    std::vector<path_query_stats_t> stats;
+};
+
+// find_path() for many queries, spread over the pool. bsp, navmesh and hpa are only
+// read, the abstract graph is used when hpa is set
+void find_paths(bsp_t const& bsp, navmesh_t const& navmesh, hpa_t const* hpa, std::span<path_query_t const> queries, path_batch_t &batch, thread_pool_t *pool = nullptr) {
+    batch.contexts.resize(pool ? pool->size() : 1);
+    batch.paths.resize(queries.size());
+    batch.stats.resize(queries.size());
+
+    auto run = [&](size_t begin, size_t end) {
+        path_query_context_t &ctx = batch.contexts[pool ? pool->thread_index() : 0];
+        for (size_t i=begin; i<end; i++) {
+            auto t0 = std::chrono::steady_clock::now();
+            ctx.path.clear(); // left alone when start sees goal
+            path_query_t const& q = queries[i];
+            bool b_found = hpa ? find_path(bsp, navmesh, *hpa, q.start, q.goal, ctx, batch.paths[i])
+                               : find_path(bsp, navmesh, q.start, q.goal, ctx, batch.paths[i]);
+            auto t1 = std::chrono::steady_clock::now();
+
+            path_query_stats_t &stats = batch.stats[i];
+            stats.found = b_found;
+            stats.cells = ctx.path.size();
+            stats.waypoints = batch.paths[i].size();
+            stats.micros = std::chrono::duration<float, std::micro>(t1 - t0).count();
+        }
+    };
+
+    // queries differ a lot in cost, small chunks keep the threads balanced
+    if (pool) pool->parallel_for(queries.size(), 8, run);
+    else run(0, queries.size());
+}
+
+// costs to one goal for all cells, many agents heading to the same goal share it
+// instead of searching each
+struct flow_field_t {
+    vec2_t goal;
+    uint32_t goal_cell = NULL_ID;
+    std::vector<float> costs; // to the goal cell, infinite if there is no route
+    std::vector<uint32_t> next_link; // link to take toward the goal, NULL_ID in the goal cell or without a route
+    node_heap_t queue;
+};
+
+// dijkstra from the goal cell over the whole navmesh. costs only depend on the goal
+// cell, so a goal that moves within it is an O(1) update. returns whether the
+// search ran, field must have been made for this navmesh if it was used before
+bool flow_field(bsp_t const& bsp, navmesh_t const& navmesh, vec2_t goal, flow_field_t &field) {
+    static constexpr float inf = std::numeric_limits<float>::infinity();
+
+    size_t len = navmesh.nodes.size();
+    id_t dest = leaf_id(bsp, 0, goal);
+    assert(dest < len);
+
+    field.goal = goal;
+    if (dest == field.goal_cell && field.costs.size() == len) return false;
+    field.goal_cell = dest;
+
+    node_heap_t &queue = field.queue;
+    queue.reset(len);
+    field.costs.assign(len, inf);
+    field.next_link.assign(len, NULL_ID);
+
+    // links come in pairs with the same weight, so costs from the goal are costs to it
+    field.costs[dest] = 0.f;
+    queue.push(dest, 0.f);
+    while (!queue.empty()) {
+        uint32_t ui = queue.pop();
+        nav_node_t const& n = navmesh.nodes[ui];
+        for (size_t i=n.links_start; i<n.links_end; i++) {
+            nav_link_t const& link = navmesh.links[i];
+            uint32_t vi = link.target;
+            if (queue.closed(vi)) continue;
+
+            float alt = field.costs[ui] + link.weight;
+            if (alt < field.costs[vi]) {
+                field.costs[vi] = alt;
+                queue.push(vi, alt);
+            }
+        }
+    }
+
+    // the way back is the link to the neighbor the cost came from
+    for (uint32_t vi=0; vi<len; vi++) {
+        if (vi == dest || inf == field.costs[vi]) continue;
+        nav_node_t const& n = navmesh.nodes[vi];
+        float best = inf;
+        for (size_t i=n.links_start; i<n.links_end; i++) {
+            nav_link_t const& link = navmesh.links[i];
+            float c = field.costs[link.target] + link.weight;
+            if (c < best) {
+                best = c;
+                field.next_link[vi] = i;
+            }
+        }
+    }
+
+    return true;
+}
+
+// where an agent at p should head next, false if there is no route. in the goal cell
+// that is the goal, else the point of the next portal on the way from p to the cell
+// after it, strictly inside the portal. the portal bounds the agent's convex cell,
+// so the step never hits a wall
+bool flow_next(bsp_t const& bsp, navmesh_t const& navmesh, flow_field_t const& field, vec2_t p, vec2_t &out) {
+    id_t cell = leaf_id(bsp, 0, p);
+    assert(cell < field.costs.size());
+
+    for (;;) {
+        if (cell == field.goal_cell) {
+            out = field.goal;
+            return true;
+        }
+        if (NULL_ID == field.next_link[cell]) return false;
+
+        nav_link_t const& link = navmesh.links[field.next_link[cell]];
+        uint32_t after = field.next_link[link.target];
+        vec2_t aim = (NULL_ID == after) ? field.goal : navmesh.nodes[navmesh.links[after].target].position;
+
+        // where p -> aim crosses the portal, kept a margin away from its ends. those are
+        // wall corners, an agent stepping onto one would stand in solid space
+        constexpr float margin = 1e-2f;
+        line_t const& portal = link.portal;
+        vec2_t e = portal.q - portal.p;
+        vec2_t d = aim - p;
+        float m = std::min(margin / std::max(dist(portal.p, portal.q), 1e-12f), 0.5f);
+        float denom = cross(d, e);
+        float t = 0.5f;
+        if (fabsf(denom) > 1e-12f) t = std::clamp(cross(d, p - portal.p) / denom, m, 1.f - m);
+        out = portal.p + e * t;
+
+        // an agent standing on the portal is already through it
+        if (dist(out, p) > 1e-3f) return true;
+        cell = link.target;
+    }
 }
 
 } // namespace navmesh
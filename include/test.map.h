@@ -0,0 +1,512 @@
+// generated by bspc from test.stl, load with bsp::deserialize() and
+// bsp::navmesh::deserialize()
+alignas(16) unsigned char test_map_bsp[] = {
+  0x41, 0x42, 0x53, 0x50, 0x02, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xe0, 0xe8, 0x7e, 0xbf, 0x40, 0xd1, 0xbc, 0xbd,
+  0xe4, 0xc2, 0x83, 0xc3, 0x01, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x00, 0x00,
+  0xd6, 0x34, 0x90, 0xbd, 0x55, 0x5d, 0x7f, 0xbf, 0x08, 0xa4, 0x11, 0xc3,
+  0x02, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x4d, 0x7c, 0x7f, 0xbf,
+  0x41, 0xc5, 0x81, 0xbd, 0x83, 0x66, 0xeb, 0xc2, 0x03, 0x00, 0x00, 0x00,
+  0x09, 0x00, 0x00, 0x00, 0xe1, 0x97, 0x74, 0x3f, 0x7d, 0x21, 0x97, 0x3e,
+  0x96, 0xe2, 0x81, 0x42, 0x04, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+  0x34, 0x61, 0x41, 0xbe, 0xc6, 0x64, 0x7b, 0x3f, 0x4f, 0xe7, 0x70, 0x40,
+  0x05, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0xc0, 0x1b, 0x3b, 0x88, 0xbd,
+  0xd9, 0x6e, 0x7f, 0x3f, 0x58, 0xa8, 0x71, 0x41, 0x00, 0x00, 0x00, 0x80,
+  0x01, 0x00, 0x00, 0xc0, 0x71, 0xfa, 0x3d, 0x3f, 0xe1, 0x97, 0x2b, 0x3f,
+  0xb3, 0x44, 0x4c, 0x42, 0x07, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0xc0,
+  0xe3, 0x17, 0x6e, 0x3f, 0x87, 0x1f, 0xbc, 0xbe, 0xbd, 0x3e, 0x69, 0x40,
+  0x08, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0xc0, 0x1b, 0x3b, 0x88, 0xbd,
+  0xd9, 0x6e, 0x7f, 0x3f, 0x58, 0xa8, 0x71, 0x41, 0x03, 0x00, 0x00, 0x80,
+  0x04, 0x00, 0x00, 0xc0, 0x34, 0x61, 0x41, 0xbe, 0xc6, 0x64, 0x7b, 0x3f,
+  0x4f, 0xe7, 0x70, 0x40, 0x0a, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00,
+  0x48, 0x41, 0x2b, 0xbf, 0x84, 0x48, 0x3e, 0xbf, 0x2d, 0x1d, 0x24, 0xc3,
+  0x07, 0x00, 0x00, 0x80, 0x0b, 0x00, 0x00, 0x00, 0x5d, 0x77, 0x55, 0x3f,
+  0x08, 0x4f, 0x0d, 0xbf, 0x03, 0xd6, 0x69, 0x42, 0x08, 0x00, 0x00, 0x80,
+  0x09, 0x00, 0x00, 0xc0, 0xd0, 0xc7, 0x03, 0x3e, 0x0b, 0xdf, 0x7d, 0x3f,
+  0x93, 0x07, 0x67, 0x42, 0x0a, 0x00, 0x00, 0x80, 0x0d, 0x00, 0x00, 0x00,
+  0x9b, 0x45, 0x70, 0x3e, 0x61, 0xda, 0x78, 0x3f, 0x16, 0x46, 0xa4, 0x42,
+  0x0b, 0x00, 0x00, 0x80, 0x0c, 0x00, 0x00, 0xc0, 0x8d, 0x70, 0x4e, 0xbf,
+  0x9e, 0x63, 0x17, 0xbf, 0x83, 0xf8, 0x57, 0xc3, 0x0f, 0x00, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x4d, 0x7c, 0x7f, 0xbf, 0x41, 0xc5, 0x81, 0xbd,
+  0x83, 0x66, 0xeb, 0xc2, 0x10, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00,
+  0xae, 0x60, 0x03, 0x3f, 0xc2, 0xb7, 0x5b, 0xbf, 0x95, 0x65, 0x47, 0xc3,
+  0x11, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0xc0, 0xe1, 0x97, 0x74, 0x3f,
+  0x7d, 0x21, 0x97, 0x3e, 0x96, 0xe2, 0x81, 0x42, 0x12, 0x00, 0x00, 0x00,
+  0x0f, 0x00, 0x00, 0xc0, 0x6a, 0xb3, 0x7f, 0x3f, 0x40, 0xf6, 0x45, 0xbd,
+  0x3e, 0x2e, 0x53, 0x41, 0x0d, 0x00, 0x00, 0x80, 0x0e, 0x00, 0x00, 0xc0,
+  0x95, 0x99, 0x19, 0xbf, 0xd0, 0xcc, 0x4c, 0x3f, 0x9c, 0x7d, 0x67, 0x42,
+  0x11, 0x00, 0x00, 0x80, 0x12, 0x00, 0x00, 0xc0, 0x79, 0xd5, 0x53, 0xbf,
+  0x87, 0xbe, 0x0f, 0x3f, 0x00, 0x5d, 0x9e, 0x41, 0x15, 0x00, 0x00, 0x00,
+  0x18, 0x00, 0x00, 0x00, 0xfd, 0x73, 0xa9, 0x3c, 0xfa, 0xf1, 0x7f, 0xbf,
+  0x46, 0x92, 0x89, 0xc3, 0x16, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0xc0,
+  0xf7, 0xd8, 0x14, 0xbe, 0xf1, 0x47, 0x7d, 0xbf, 0x29, 0x62, 0x94, 0xc3,
+  0x17, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0xc0, 0xae, 0x60, 0x03, 0x3f,
+  0xc2, 0xb7, 0x5b, 0xbf, 0x95, 0x65, 0x47, 0xc3, 0x13, 0x00, 0x00, 0x80,
+  0x14, 0x00, 0x00, 0xc0, 0x9a, 0x25, 0x61, 0x3f, 0xdd, 0xad, 0xf3, 0xbe,
+  0xae, 0x84, 0xe6, 0x42, 0x17, 0x00, 0x00, 0x80, 0x19, 0x00, 0x00, 0x00,
+  0x87, 0xd0, 0xbd, 0x3e, 0xe9, 0xc1, 0x6d, 0x3f, 0xdf, 0xbe, 0x7b, 0x43,
+  0x1a, 0x00, 0x00, 0x00, 0x1a, 0x00, 0x00, 0xc0, 0xf7, 0xd8, 0x14, 0xbe,
+  0xf1, 0x47, 0x7d, 0xbf, 0x29, 0x62, 0x94, 0xc3, 0x18, 0x00, 0x00, 0x80,
+  0x19, 0x00, 0x00, 0xc0, 0xc3, 0xb3, 0x08, 0xbf, 0xf6, 0x71, 0x58, 0x3f,
+  0x18, 0xbe, 0x86, 0xc2, 0x1c, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00,
+  0x2a, 0xb5, 0x23, 0x3d, 0xa3, 0xcb, 0x7f, 0x3f, 0x76, 0xa2, 0x7c, 0x43,
+  0x1d, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0xf7, 0xd8, 0x14, 0xbe,
+  0xf1, 0x47, 0x7d, 0xbf, 0x29, 0x62, 0x94, 0xc3, 0x1e, 0x00, 0x00, 0x00,
+  0x1f, 0x00, 0x00, 0x00, 0x70, 0x4f, 0x39, 0xbf, 0xc9, 0x9f, 0x30, 0xbf,
+  0xdd, 0xb7, 0xd7, 0xc3, 0x1b, 0x00, 0x00, 0x80, 0x1c, 0x00, 0x00, 0xc0,
+  0x70, 0x4f, 0x39, 0xbf, 0xc9, 0x9f, 0x30, 0xbf, 0xdd, 0xb7, 0xd7, 0xc3,
+  0x20, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0xc0, 0x0a, 0xf0, 0x96, 0xbe,
+  0x83, 0x9f, 0x74, 0xbf, 0x67, 0x76, 0xab, 0xc3, 0x21, 0x00, 0x00, 0x00,
+  0x1f, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x80, 0xbf,
+  0x80, 0x48, 0x83, 0xc3, 0x1d, 0x00, 0x00, 0x80, 0x1e, 0x00, 0x00, 0xc0,
+  0x12, 0xe6, 0x24, 0x3f, 0x3a, 0xd1, 0x43, 0xbf, 0xe1, 0x77, 0x52, 0x42,
+  0x23, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0x70, 0x4f, 0x39, 0xbf,
+  0xc9, 0x9f, 0x30, 0xbf, 0xdd, 0xb7, 0xd7, 0xc3, 0x24, 0x00, 0x00, 0x00,
+  0x23, 0x00, 0x00, 0xc0, 0x24, 0x26, 0x7c, 0xbf, 0x71, 0xf2, 0x30, 0x3e,
+  0xf7, 0xc0, 0xad, 0xc3, 0x21, 0x00, 0x00, 0x80, 0x22, 0x00, 0x00, 0xc0,
+  0xa7, 0xc4, 0x36, 0xbf, 0xe1, 0x40, 0x33, 0xbf, 0x9a, 0x84, 0xab, 0xc3,
+  0x24, 0x00, 0x00, 0x80, 0x26, 0x00, 0x00, 0x00, 0xa0, 0x33, 0x1f, 0x3f,
+  0xfc, 0x79, 0x48, 0x3f, 0xc1, 0xf3, 0xbe, 0x43, 0x25, 0x00, 0x00, 0x80,
+  0x27, 0x00, 0x00, 0x00, 0x97, 0xc8, 0x4d, 0xbf, 0x9f, 0x47, 0x18, 0x3f,
+  0xcf, 0x4e, 0xa2, 0xc2, 0x26, 0x00, 0x00, 0x80, 0x28, 0x00, 0x00, 0x00,
+  0x5a, 0x84, 0x2a, 0xbd, 0x30, 0xc7, 0x7f, 0xbf, 0x17, 0x58, 0x52, 0xc3,
+  0x27, 0x00, 0x00, 0x80, 0x28, 0x00, 0x00, 0xc0, 0x85, 0xce, 0x29, 0x3f,
+  0xab, 0x93, 0x3f, 0x3f, 0x32, 0x5c, 0x86, 0x43, 0x2a, 0x00, 0x00, 0x00,
+  0x31, 0x00, 0x00, 0x00, 0xa0, 0x08, 0x89, 0xbe, 0x1c, 0xa9, 0x76, 0x3f,
+  0x13, 0xa9, 0x71, 0x3f, 0x2b, 0x00, 0x00, 0x00, 0x2e, 0x00, 0x00, 0x00,
+  0x63, 0xc4, 0x73, 0xbf, 0xfc, 0x60, 0x9c, 0x3e, 0x8e, 0x0f, 0x9d, 0xc3,
+  0x2c, 0x00, 0x00, 0x00, 0x2d, 0x00, 0x00, 0x00, 0x24, 0x26, 0x7c, 0xbf,
+  0x71, 0xf2, 0x30, 0x3e, 0xf7, 0xc0, 0xad, 0xc3, 0x29, 0x00, 0x00, 0x80,
+  0x2a, 0x00, 0x00, 0xc0, 0xc4, 0x58, 0x75, 0xbf, 0xfa, 0x29, 0x92, 0xbe,
+  0x69, 0xf3, 0xbc, 0xc3, 0x2b, 0x00, 0x00, 0x80, 0x2c, 0x00, 0x00, 0xc0,
+  0x89, 0x13, 0x7e, 0xbf, 0xd7, 0x98, 0xfa, 0x3d, 0x0d, 0xda, 0xb7, 0xc3,
+  0x2f, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0xc0, 0xee, 0xe3, 0x7c, 0x3f,
+  0x0e, 0x1f, 0x1f, 0x3e, 0x1c, 0x65, 0xaa, 0x43, 0x30, 0x00, 0x00, 0x00,
+  0x2f, 0x00, 0x00, 0xc0, 0xc4, 0x58, 0x75, 0xbf, 0xfa, 0x29, 0x92, 0xbe,
+  0x69, 0xf3, 0xbc, 0xc3, 0x2d, 0x00, 0x00, 0x80, 0x2e, 0x00, 0x00, 0xc0,
+  0xee, 0xe3, 0x7c, 0x3f, 0x0e, 0x1f, 0x1f, 0x3e, 0x1c, 0x65, 0xaa, 0x43,
+  0x32, 0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x89, 0x13, 0x7e, 0xbf,
+  0xd7, 0x98, 0xfa, 0x3d, 0x0d, 0xda, 0xb7, 0xc3, 0x33, 0x00, 0x00, 0x00,
+  0x33, 0x00, 0x00, 0xc0, 0xbb, 0x82, 0x17, 0xbe, 0xac, 0x2e, 0x7d, 0x3f,
+  0xca, 0x18, 0x0f, 0xc2, 0x31, 0x00, 0x00, 0x80, 0x32, 0x00, 0x00, 0xc0,
+  0x1a, 0x3b, 0x3d, 0x3e, 0x45, 0x97, 0x7b, 0xbf, 0xff, 0x32, 0xfc, 0x40,
+  0x35, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0xbb, 0x82, 0x17, 0xbe,
+  0xac, 0x2e, 0x7d, 0x3f, 0xca, 0x18, 0x0f, 0xc2, 0x36, 0x00, 0x00, 0x00,
+  0x36, 0x00, 0x00, 0xc0, 0x9b, 0x45, 0x70, 0x3e, 0x61, 0xda, 0x78, 0x3f,
+  0x16, 0x46, 0xa4, 0x42, 0x34, 0x00, 0x00, 0x80, 0x35, 0x00, 0x00, 0xc0,
+  0x21, 0xf9, 0xe4, 0xbe, 0x31, 0xf9, 0x64, 0xbf, 0xa1, 0x69, 0x29, 0xc3,
+  0x37, 0x00, 0x00, 0x80, 0x38, 0x00, 0x00, 0xc0, 0xca, 0x8d, 0x81, 0x43,
+  0xd1, 0x6b, 0x6f, 0x42, 0xda, 0x7f, 0x80, 0x43, 0x7e, 0x43, 0xa5, 0x42,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x01, 0x00, 0x00, 0x00,
+  0x1b, 0x00, 0x00, 0x00, 0xcb, 0x55, 0x4a, 0x43, 0x7a, 0xb8, 0x03, 0x43,
+  0x14, 0x50, 0x1f, 0x43, 0xeb, 0xc1, 0x06, 0x43, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x02, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00,
+  0xf6, 0x6e, 0xdc, 0x42, 0x08, 0x32, 0xf3, 0x42, 0x60, 0x62, 0xd8, 0x42,
+  0x20, 0x7c, 0x19, 0x43, 0x00, 0x00, 0x00, 0x00, 0x24, 0x13, 0x06, 0x3f,
+  0x03, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x3e, 0x08, 0xa5, 0x41,
+  0x33, 0x3d, 0x19, 0x43, 0x3e, 0x73, 0x1f, 0x42, 0x67, 0xf7, 0xb5, 0x42,
+  0x36, 0x28, 0x12, 0x3e, 0x00, 0x00, 0x80, 0x3f, 0x04, 0x00, 0x00, 0x00,
+  0x06, 0x00, 0x00, 0x00, 0x1c, 0xf1, 0xb3, 0x42, 0xdc, 0x14, 0xa9, 0x41,
+  0xf8, 0xed, 0x28, 0x43, 0x35, 0x47, 0x11, 0x42, 0x00, 0x00, 0x00, 0x00,
+  0x90, 0x8f, 0xaa, 0x3e, 0x05, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0xc0,
+  0x43, 0x0a, 0x50, 0x42, 0xef, 0xd5, 0x94, 0x41, 0x1c, 0xf1, 0xb3, 0x42,
+  0xdc, 0x14, 0xa9, 0x41, 0x73, 0xf9, 0x86, 0x3e, 0x00, 0x00, 0x80, 0x3f,
+  0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00, 0xc0, 0xc1, 0x53, 0xbd, 0x41,
+  0x1c, 0xf1, 0x47, 0x42, 0x43, 0x0a, 0x50, 0x42, 0xef, 0xd5, 0x94, 0x41,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x07, 0x00, 0x00, 0x00,
+  0x06, 0x00, 0x00, 0xc0, 0x3e, 0x73, 0x1f, 0x42, 0x67, 0xf7, 0xb5, 0x42,
+  0xc1, 0x53, 0xbd, 0x41, 0x1c, 0xf1, 0x47, 0x42, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x08, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0xc0,
+  0x43, 0x0a, 0x50, 0x42, 0xef, 0xd5, 0x94, 0x41, 0x1c, 0xf1, 0xb3, 0x42,
+  0xdc, 0x14, 0xa9, 0x41, 0x00, 0x00, 0x00, 0x00, 0x73, 0xf9, 0x86, 0x3e,
+  0x03, 0x00, 0x00, 0x80, 0x04, 0x00, 0x00, 0xc0, 0x1c, 0xf1, 0xb3, 0x42,
+  0xdc, 0x14, 0xa9, 0x41, 0xf8, 0xed, 0x28, 0x43, 0x35, 0x47, 0x11, 0x42,
+  0x90, 0x8f, 0xaa, 0x3e, 0x00, 0x00, 0x80, 0x3f, 0x0a, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x23, 0x86, 0x07, 0x43, 0x72, 0xa4, 0xc5, 0x42,
+  0xf6, 0x6e, 0xdc, 0x42, 0x08, 0x32, 0xf3, 0x42, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x07, 0x00, 0x00, 0x80, 0x0b, 0x00, 0x00, 0x00,
+  0x14, 0x50, 0x1f, 0x43, 0xeb, 0xc1, 0x06, 0x43, 0x23, 0x86, 0x07, 0x43,
+  0x72, 0xa4, 0xc5, 0x42, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f,
+  0x08, 0x00, 0x00, 0x80, 0x09, 0x00, 0x00, 0xc0, 0xf8, 0xed, 0x28, 0x43,
+  0x35, 0x47, 0x11, 0x42, 0x0c, 0x3c, 0x6b, 0x43, 0x78, 0xb8, 0xdd, 0x41,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x0a, 0x00, 0x00, 0x80,
+  0x0d, 0x00, 0x00, 0x00, 0x0c, 0x3c, 0x6b, 0x43, 0x78, 0xb8, 0xdd, 0x41,
+  0x14, 0x50, 0x9a, 0x43, 0xf8, 0xff, 0x1f, 0x41, 0x00, 0x00, 0x00, 0x00,
+  0xf2, 0x96, 0xbf, 0x3e, 0x0b, 0x00, 0x00, 0x80, 0x0c, 0x00, 0x00, 0xc0,
+  0x94, 0x8f, 0x0a, 0x43, 0xea, 0x42, 0x30, 0x43, 0xb8, 0x94, 0xe8, 0x42,
+  0x4d, 0xa1, 0x4e, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f,
+  0x0f, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0xf6, 0x6e, 0xdc, 0x42,
+  0x08, 0x32, 0xf3, 0x42, 0x60, 0x62, 0xd8, 0x42, 0x20, 0x7c, 0x19, 0x43,
+  0x24, 0x13, 0x06, 0x3f, 0x00, 0x00, 0x80, 0x3f, 0x10, 0x00, 0x00, 0x00,
+  0x13, 0x00, 0x00, 0x00, 0x91, 0x8f, 0x94, 0x42, 0x86, 0x5e, 0x8a, 0x43,
+  0x82, 0x79, 0xc9, 0x41, 0xce, 0x61, 0x77, 0x43, 0x61, 0x55, 0x08, 0x3e,
+  0x00, 0x00, 0x80, 0x3f, 0x11, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0xc0,
+  0x3e, 0x08, 0xa5, 0x41, 0x33, 0x3d, 0x19, 0x43, 0x3e, 0x73, 0x1f, 0x42,
+  0x67, 0xf7, 0xb5, 0x42, 0x00, 0x00, 0x00, 0x00, 0x36, 0x28, 0x12, 0x3e,
+  0x12, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0xc0, 0x82, 0x79, 0xc9, 0x41,
+  0xce, 0x61, 0x77, 0x43, 0x3e, 0x08, 0xa5, 0x41, 0x33, 0x3d, 0x19, 0x43,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x0d, 0x00, 0x00, 0x80,
+  0x0e, 0x00, 0x00, 0xc0, 0x60, 0x62, 0xd8, 0x42, 0x20, 0x7c, 0x19, 0x43,
+  0x94, 0x8f, 0x0a, 0x43, 0xea, 0x42, 0x30, 0x43, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x11, 0x00, 0x00, 0x80, 0x12, 0x00, 0x00, 0xc0,
+  0xb8, 0x94, 0xe8, 0x42, 0x4d, 0xa1, 0x4e, 0x43, 0x7f, 0xd0, 0xfb, 0x42,
+  0x5a, 0xcd, 0x5c, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f,
+  0x15, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0xe4, 0xab, 0x13, 0x43,
+  0xe2, 0x20, 0x8b, 0x43, 0x91, 0x8f, 0x94, 0x42, 0x86, 0x5e, 0x8a, 0x43,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x16, 0x00, 0x00, 0x00,
+  0x16, 0x00, 0x00, 0xc0, 0xd4, 0x77, 0x7e, 0x43, 0x80, 0x48, 0x83, 0x43,
+  0xe4, 0xab, 0x13, 0x43, 0xe2, 0x20, 0x8b, 0x43, 0x4a, 0x75, 0x5a, 0x3f,
+  0x00, 0x00, 0x80, 0x3f, 0x17, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0xc0,
+  0x91, 0x8f, 0x94, 0x42, 0x86, 0x5e, 0x8a, 0x43, 0x82, 0x79, 0xc9, 0x41,
+  0xce, 0x61, 0x77, 0x43, 0x00, 0x00, 0x00, 0x00, 0x61, 0x55, 0x08, 0x3e,
+  0x13, 0x00, 0x00, 0x80, 0x14, 0x00, 0x00, 0xc0, 0xd0, 0x66, 0x64, 0x43,
+  0x86, 0xe3, 0x33, 0x43, 0xcb, 0x55, 0x4a, 0x43, 0x7a, 0xb8, 0x03, 0x43,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x17, 0x00, 0x00, 0x80,
+  0x19, 0x00, 0x00, 0x00, 0x7f, 0xd0, 0xfb, 0x42, 0x5a, 0xcd, 0x5c, 0x43,
+  0xd0, 0x66, 0x64, 0x43, 0x86, 0xe3, 0x33, 0x43, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x1a, 0x00, 0x00, 0x00, 0x1a, 0x00, 0x00, 0xc0,
+  0xd4, 0x77, 0x7e, 0x43, 0x80, 0x48, 0x83, 0x43, 0xe4, 0xab, 0x13, 0x43,
+  0xe2, 0x20, 0x8b, 0x43, 0x90, 0x58, 0x09, 0x3e, 0x4a, 0x75, 0x5a, 0x3f,
+  0x18, 0x00, 0x00, 0x80, 0x19, 0x00, 0x00, 0xc0, 0xda, 0x7f, 0x80, 0x43,
+  0x7e, 0x43, 0xa5, 0x42, 0x00, 0x87, 0x90, 0x43, 0x57, 0xc1, 0xcd, 0x42,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x1c, 0x00, 0x00, 0x00,
+  0x29, 0x00, 0x00, 0x00, 0x3e, 0xe3, 0x8b, 0x43, 0x4e, 0xa5, 0x71, 0x43,
+  0x66, 0xb4, 0x9b, 0x43, 0x60, 0x61, 0x70, 0x43, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x1d, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,
+  0xd4, 0x77, 0x7e, 0x43, 0x80, 0x48, 0x83, 0x43, 0xe4, 0xab, 0x13, 0x43,
+  0xe2, 0x20, 0x8b, 0x43, 0x00, 0x00, 0x00, 0x00, 0x90, 0x58, 0x09, 0x3e,
+  0x1e, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x82, 0x4f, 0xc3, 0x43,
+  0xb2, 0x7e, 0x57, 0x43, 0x85, 0xdf, 0xb3, 0x43, 0x61, 0xe3, 0x77, 0x43,
+  0xec, 0x6d, 0x32, 0x3f, 0x5f, 0xbf, 0x78, 0x3f, 0x1b, 0x00, 0x00, 0x80,
+  0x1c, 0x00, 0x00, 0xc0, 0x82, 0x4f, 0xc3, 0x43, 0xb2, 0x7e, 0x57, 0x43,
+  0x85, 0xdf, 0xb3, 0x43, 0x61, 0xe3, 0x77, 0x43, 0x5f, 0xbf, 0x78, 0x3f,
+  0x00, 0x00, 0x80, 0x3f, 0x20, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0xc0,
+  0x85, 0xdf, 0xb3, 0x43, 0x61, 0xe3, 0x77, 0x43, 0x95, 0x15, 0x9c, 0x43,
+  0x80, 0x48, 0x83, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f,
+  0x21, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0xc0, 0x95, 0x15, 0x9c, 0x43,
+  0x80, 0x48, 0x83, 0x43, 0xd4, 0x77, 0x7e, 0x43, 0x80, 0x48, 0x83, 0x43,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x1d, 0x00, 0x00, 0x80,
+  0x1e, 0x00, 0x00, 0xc0, 0xa5, 0x0b, 0xaa, 0x43, 0x95, 0x9a, 0x59, 0x43,
+  0x48, 0x06, 0x9e, 0x43, 0xa8, 0x5b, 0x45, 0x43, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x23, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00,
+  0x82, 0x4f, 0xc3, 0x43, 0xb2, 0x7e, 0x57, 0x43, 0x85, 0xdf, 0xb3, 0x43,
+  0x61, 0xe3, 0x77, 0x43, 0x00, 0x00, 0x00, 0x00, 0xec, 0x6d, 0x32, 0x3f,
+  0x24, 0x00, 0x00, 0x00, 0x23, 0x00, 0x00, 0xc0, 0xc6, 0x3f, 0xbe, 0x43,
+  0x5b, 0xcb, 0x1d, 0x43, 0x82, 0x4f, 0xc3, 0x43, 0xb2, 0x7e, 0x57, 0x43,
+  0xf9, 0x7d, 0x62, 0x3d, 0x00, 0x00, 0x80, 0x3f, 0x21, 0x00, 0x00, 0x80,
+  0x22, 0x00, 0x00, 0xc0, 0x16, 0xd7, 0x8e, 0x43, 0x96, 0x9f, 0x46, 0x43,
+  0xa8, 0x15, 0x84, 0x43, 0x6c, 0x8e, 0x5c, 0x43, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x24, 0x00, 0x00, 0x80, 0x26, 0x00, 0x00, 0x00,
+  0x66, 0xb4, 0x9b, 0x43, 0x60, 0x61, 0x70, 0x43, 0xa5, 0x0b, 0xaa, 0x43,
+  0x95, 0x9a, 0x59, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f,
+  0x25, 0x00, 0x00, 0x80, 0x27, 0x00, 0x00, 0x00, 0xa8, 0x15, 0x84, 0x43,
+  0x6c, 0x8e, 0x5c, 0x43, 0x3e, 0xe3, 0x8b, 0x43, 0x4e, 0xa5, 0x71, 0x43,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x26, 0x00, 0x00, 0x80,
+  0x28, 0x00, 0x00, 0x00, 0x48, 0x06, 0x9e, 0x43, 0xa8, 0x5b, 0x45, 0x43,
+  0x16, 0xd7, 0x8e, 0x43, 0x96, 0x9f, 0x46, 0x43, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x27, 0x00, 0x00, 0x80, 0x28, 0x00, 0x00, 0xc0,
+  0x00, 0x87, 0x90, 0x43, 0x57, 0xc1, 0xcd, 0x42, 0x82, 0xce, 0x99, 0x43,
+  0x16, 0xdb, 0xac, 0x42, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f,
+  0x2a, 0x00, 0x00, 0x00, 0x31, 0x00, 0x00, 0x00, 0x82, 0xce, 0x99, 0x43,
+  0x16, 0xdb, 0xac, 0x42, 0xe7, 0x31, 0xa5, 0x43, 0x6a, 0x82, 0xb9, 0x42,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x2b, 0x00, 0x00, 0x00,
+  0x2e, 0x00, 0x00, 0x00, 0x08, 0xa5, 0xb5, 0x43, 0x35, 0x49, 0xd0, 0x42,
+  0xc6, 0x3f, 0xbe, 0x43, 0x5b, 0xcb, 0x1d, 0x43, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x2c, 0x00, 0x00, 0x00, 0x2d, 0x00, 0x00, 0x00,
+  0xc6, 0x3f, 0xbe, 0x43, 0x5b, 0xcb, 0x1d, 0x43, 0x82, 0x4f, 0xc3, 0x43,
+  0xb2, 0x7e, 0x57, 0x43, 0x00, 0x00, 0x00, 0x00, 0xf9, 0x7d, 0x62, 0x3d,
+  0x29, 0x00, 0x00, 0x80, 0x2a, 0x00, 0x00, 0xc0, 0x0e, 0xbb, 0xbc, 0x43,
+  0xe9, 0x42, 0x62, 0x42, 0x08, 0xa5, 0xb5, 0x43, 0x35, 0x49, 0xd0, 0x42,
+  0x2c, 0xd2, 0x74, 0x3f, 0x00, 0x00, 0x80, 0x3f, 0x2b, 0x00, 0x00, 0x80,
+  0x2c, 0x00, 0x00, 0xc0, 0xf9, 0x73, 0xba, 0x43, 0x1a, 0xef, 0x9c, 0x41,
+  0x0e, 0xbb, 0xbc, 0x43, 0xe9, 0x42, 0x62, 0x42, 0x10, 0x4f, 0x5f, 0x3e,
+  0x00, 0x00, 0x80, 0x3f, 0x2f, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0xc0,
+  0xe7, 0x31, 0xa5, 0x43, 0x6a, 0x82, 0xb9, 0x42, 0xbe, 0x25, 0xa8, 0x43,
+  0xcd, 0xdc, 0x5c, 0x42, 0x00, 0x00, 0x00, 0x00, 0x08, 0x1e, 0x52, 0x3f,
+  0x30, 0x00, 0x00, 0x00, 0x2f, 0x00, 0x00, 0xc0, 0x0e, 0xbb, 0xbc, 0x43,
+  0xe9, 0x42, 0x62, 0x42, 0x08, 0xa5, 0xb5, 0x43, 0x35, 0x49, 0xd0, 0x42,
+  0x00, 0x00, 0x00, 0x00, 0x2c, 0xd2, 0x74, 0x3f, 0x2d, 0x00, 0x00, 0x80,
+  0x2e, 0x00, 0x00, 0xc0, 0xe7, 0x31, 0xa5, 0x43, 0x6a, 0x82, 0xb9, 0x42,
+  0xbe, 0x25, 0xa8, 0x43, 0xcd, 0xdc, 0x5c, 0x42, 0x08, 0x1e, 0x52, 0x3f,
+  0x00, 0x00, 0x80, 0x3f, 0x32, 0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00,
+  0xf9, 0x73, 0xba, 0x43, 0x1a, 0xef, 0x9c, 0x41, 0x0e, 0xbb, 0xbc, 0x43,
+  0xe9, 0x42, 0x62, 0x42, 0x00, 0x00, 0x00, 0x00, 0x10, 0x4f, 0x5f, 0x3e,
+  0x33, 0x00, 0x00, 0x00, 0x33, 0x00, 0x00, 0xc0, 0x14, 0x50, 0x9a, 0x43,
+  0xf8, 0xff, 0x1f, 0x41, 0xf9, 0x73, 0xba, 0x43, 0x1a, 0xef, 0x9c, 0x41,
+  0xd7, 0x55, 0x07, 0x3f, 0x00, 0x00, 0x80, 0x3f, 0x31, 0x00, 0x00, 0x80,
+  0x32, 0x00, 0x00, 0xc0, 0xbe, 0x25, 0xa8, 0x43, 0xcd, 0xdc, 0x5c, 0x42,
+  0x0e, 0x79, 0x8f, 0x43, 0xc5, 0xbe, 0x37, 0x42, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x35, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00,
+  0x14, 0x50, 0x9a, 0x43, 0xf8, 0xff, 0x1f, 0x41, 0xf9, 0x73, 0xba, 0x43,
+  0x1a, 0xef, 0x9c, 0x41, 0x00, 0x00, 0x00, 0x00, 0xd7, 0x55, 0x07, 0x3f,
+  0x36, 0x00, 0x00, 0x00, 0x36, 0x00, 0x00, 0xc0, 0x0c, 0x3c, 0x6b, 0x43,
+  0x78, 0xb8, 0xdd, 0x41, 0x14, 0x50, 0x9a, 0x43, 0xf8, 0xff, 0x1f, 0x41,
+  0xf2, 0x96, 0xbf, 0x3e, 0x00, 0x00, 0x80, 0x3f, 0x34, 0x00, 0x00, 0x80,
+  0x35, 0x00, 0x00, 0xc0, 0x0e, 0x79, 0x8f, 0x43, 0xc5, 0xbe, 0x37, 0x42,
+  0xca, 0x8d, 0x81, 0x43, 0xd1, 0x6b, 0x6f, 0x42, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x80, 0x3f, 0x37, 0x00, 0x00, 0x80, 0x38, 0x00, 0x00, 0xc0
+};
+unsigned int test_map_bsp_len = 2928;
+alignas(16) unsigned char test_map_navmesh[] = {
+  0x41, 0x4e, 0x41, 0x56, 0x01, 0x00, 0x00, 0x00, 0x39, 0x00, 0x00, 0x00,
+  0x4e, 0x00, 0x00, 0x00, 0x35, 0x51, 0xa0, 0x42, 0x5a, 0xb3, 0x8b, 0x42,
+  0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+  0x03, 0x00, 0x00, 0x00, 0x4a, 0x8e, 0x31, 0x42, 0x41, 0xd8, 0x32, 0x42,
+  0x03, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x8f, 0xb4, 0x0d, 0x43,
+  0x5f, 0x18, 0x7d, 0x42, 0x04, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+  0xed, 0x2e, 0x49, 0x43, 0xeb, 0x03, 0xb7, 0x42, 0x07, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x44, 0x56, 0x66, 0x43,
+  0xd7, 0x5e, 0x18, 0x42, 0x0c, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00,
+  0x87, 0x72, 0x7d, 0x43, 0x99, 0xa3, 0xc2, 0x41, 0x11, 0x00, 0x00, 0x00,
+  0x13, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x13, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x50, 0x36, 0x69, 0x42,
+  0xaf, 0xa4, 0x44, 0x43, 0x13, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00,
+  0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x16, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00,
+  0xd5, 0xa7, 0xe9, 0x42, 0x51, 0x80, 0x38, 0x43, 0x16, 0x00, 0x00, 0x00,
+  0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x43, 0xba, 0xe3, 0x42,
+  0x88, 0x0a, 0x83, 0x43, 0x18, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x00, 0x00,
+  0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x1b, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x00, 0x00,
+  0xa9, 0x6a, 0x69, 0x43, 0x05, 0xe5, 0x1c, 0x43, 0x1b, 0x00, 0x00, 0x00,
+  0x1f, 0x00, 0x00, 0x00, 0x59, 0x95, 0x48, 0x43, 0x9d, 0x6c, 0x66, 0x43,
+  0x1f, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00,
+  0x24, 0x00, 0x00, 0x00, 0x16, 0x80, 0x97, 0x43, 0x62, 0x37, 0x78, 0x43,
+  0x24, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00,
+  0x1e, 0xe0, 0xa0, 0x43, 0x75, 0xff, 0x7e, 0x43, 0x29, 0x00, 0x00, 0x00,
+  0x2a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x2a, 0x00, 0x00, 0x00, 0x2a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x2a, 0x00, 0x00, 0x00, 0x2a, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2a, 0x00, 0x00, 0x00,
+  0x2a, 0x00, 0x00, 0x00, 0x34, 0xd1, 0xa7, 0x43, 0x50, 0xba, 0x33, 0x43,
+  0x2a, 0x00, 0x00, 0x00, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x31, 0x00, 0x00, 0x00, 0x31, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x31, 0x00, 0x00, 0x00,
+  0x31, 0x00, 0x00, 0x00, 0xeb, 0x46, 0x84, 0x43, 0x3d, 0xf4, 0x3d, 0x43,
+  0x31, 0x00, 0x00, 0x00, 0x36, 0x00, 0x00, 0x00, 0x17, 0x5a, 0xa9, 0x43,
+  0x30, 0x14, 0x68, 0x43, 0x36, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00,
+  0x60, 0x87, 0x80, 0x43, 0x1a, 0x17, 0x6d, 0x43, 0x38, 0x00, 0x00, 0x00,
+  0x3b, 0x00, 0x00, 0x00, 0xe9, 0x4d, 0x96, 0x43, 0x4c, 0x4d, 0x41, 0x43,
+  0x3b, 0x00, 0x00, 0x00, 0x3d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x3d, 0x00, 0x00, 0x00, 0x3d, 0x00, 0x00, 0x00,
+  0x78, 0x12, 0xac, 0x43, 0x3d, 0xe7, 0xf3, 0x42, 0x3d, 0x00, 0x00, 0x00,
+  0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x40, 0x00, 0x00, 0x00, 0x40, 0x00, 0x00, 0x00, 0xa4, 0x9d, 0xb5, 0x43,
+  0x28, 0x41, 0xcd, 0x42, 0x40, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x00,
+  0x42, 0x00, 0x00, 0x00, 0xeb, 0x16, 0xb2, 0x43, 0xbe, 0x66, 0x88, 0x42,
+  0x42, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x00,
+  0x45, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x45, 0x00, 0x00, 0x00, 0x45, 0x00, 0x00, 0x00, 0xca, 0x14, 0xb2, 0x43,
+  0x24, 0xa3, 0xf8, 0x41, 0x45, 0x00, 0x00, 0x00, 0x47, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x47, 0x00, 0x00, 0x00,
+  0x47, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x47, 0x00, 0x00, 0x00, 0x47, 0x00, 0x00, 0x00, 0x8e, 0x1b, 0x97, 0x43,
+  0x43, 0xdd, 0xe3, 0x41, 0x47, 0x00, 0x00, 0x00, 0x4b, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x00, 0x00, 0x00,
+  0x4b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x4b, 0x00, 0x00, 0x00, 0x4b, 0x00, 0x00, 0x00, 0xec, 0x7b, 0x86, 0x43,
+  0xf3, 0xc2, 0x43, 0x42, 0x4b, 0x00, 0x00, 0x00, 0x4e, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4e, 0x00, 0x00, 0x00,
+  0x4e, 0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x13, 0x50, 0xda, 0x42, 0x47, 0x4c, 0x0a, 0x43, 0x78, 0xfe, 0xba, 0x41,
+  0x6b, 0x5a, 0x10, 0x43, 0xb1, 0xa9, 0x00, 0x43, 0x07, 0x00, 0x00, 0x00,
+  0x02, 0x00, 0x00, 0x00, 0x5b, 0x8c, 0xe8, 0x42, 0x50, 0x8c, 0xd1, 0x41,
+  0xf6, 0x6e, 0xdc, 0x42, 0x07, 0x32, 0xf3, 0x42, 0x98, 0x96, 0x77, 0x42,
+  0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x3e, 0x73, 0x1f, 0x42,
+  0x68, 0xf7, 0xb5, 0x42, 0xc2, 0x11, 0x78, 0x42, 0x48, 0x2c, 0x9a, 0x41,
+  0x55, 0xe1, 0x2e, 0x42, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+  0xc2, 0x11, 0x78, 0x42, 0x48, 0x2c, 0x9a, 0x41, 0x3e, 0x73, 0x1f, 0x42,
+  0x68, 0xf7, 0xb5, 0x42, 0x55, 0xe1, 0x2e, 0x42, 0x00, 0x00, 0x00, 0x00,
+  0x02, 0x00, 0x00, 0x00, 0xf6, 0x6e, 0xdc, 0x42, 0x07, 0x32, 0xf3, 0x42,
+  0x5b, 0x8c, 0xe8, 0x42, 0x50, 0x8c, 0xd1, 0x41, 0x98, 0x96, 0x77, 0x42,
+  0x0a, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0xf8, 0xed, 0x28, 0x43,
+  0x36, 0x47, 0x11, 0x42, 0x02, 0xa0, 0x46, 0x43, 0xee, 0x1e, 0x28, 0x42,
+  0x5d, 0x47, 0xb8, 0x42, 0x08, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+  0x02, 0xa0, 0x46, 0x43, 0xee, 0x1e, 0x28, 0x42, 0x23, 0x86, 0x07, 0x43,
+  0x72, 0xa4, 0xc5, 0x42, 0x9a, 0xad, 0x83, 0x42, 0x37, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xe9, 0xd5, 0x81, 0x43, 0x52, 0x14, 0x57, 0x42,
+  0xca, 0x8d, 0x81, 0x43, 0xcf, 0x6b, 0x6f, 0x42, 0x9e, 0x15, 0xa0, 0x42,
+  0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xda, 0x7f, 0x80, 0x43,
+  0x80, 0x43, 0xa5, 0x42, 0x8e, 0xc8, 0x7c, 0x43, 0xd8, 0x28, 0x00, 0x43,
+  0x63, 0xcf, 0x20, 0x43, 0x17, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+  0x8f, 0xc8, 0x7c, 0x43, 0xd8, 0x28, 0x00, 0x43, 0xcb, 0x55, 0x4a, 0x43,
+  0x7a, 0xb8, 0x03, 0x43, 0xea, 0xcc, 0x91, 0x42, 0x0a, 0x00, 0x00, 0x00,
+  0x09, 0x00, 0x00, 0x00, 0x02, 0xa0, 0x46, 0x43, 0xee, 0x1e, 0x28, 0x42,
+  0xea, 0xd5, 0x81, 0x43, 0x54, 0x14, 0x57, 0x42, 0x99, 0x69, 0x73, 0x42,
+  0x07, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x23, 0x86, 0x07, 0x43,
+  0x72, 0xa4, 0xc5, 0x42, 0x02, 0xa0, 0x46, 0x43, 0xee, 0x1e, 0x28, 0x42,
+  0x9a, 0xad, 0x83, 0x42, 0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x7f, 0x34, 0x83, 0x43, 0xf8, 0x81, 0xc1, 0x41, 0xe7, 0x6c, 0x82, 0x43,
+  0x44, 0x1e, 0x24, 0x42, 0x1f, 0x09, 0x91, 0x42, 0x37, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xe7, 0x6c, 0x82, 0x43, 0x44, 0x1e, 0x24, 0x42,
+  0xe9, 0xd5, 0x81, 0x43, 0x52, 0x14, 0x57, 0x42, 0x52, 0x80, 0x20, 0x42,
+  0x07, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x02, 0xa0, 0x46, 0x43,
+  0xee, 0x1e, 0x28, 0x42, 0xf8, 0xed, 0x28, 0x43, 0x36, 0x47, 0x11, 0x42,
+  0x5d, 0x47, 0xb8, 0x42, 0x08, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00,
+  0xea, 0xd5, 0x81, 0x43, 0x54, 0x14, 0x57, 0x42, 0x02, 0xa0, 0x46, 0x43,
+  0xee, 0x1e, 0x28, 0x42, 0x99, 0x69, 0x73, 0x42, 0x0b, 0x00, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x0c, 0x3c, 0x6b, 0x43, 0x78, 0xb8, 0xdd, 0x41,
+  0x80, 0x34, 0x83, 0x43, 0xfb, 0x81, 0xc1, 0x41, 0x24, 0x2f, 0xd7, 0x41,
+  0x34, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x44, 0x59, 0x83, 0x43,
+  0x56, 0xb0, 0xa8, 0x41, 0x7f, 0x34, 0x83, 0x43, 0xf8, 0x81, 0xc1, 0x41,
+  0x17, 0xc7, 0x43, 0x42, 0x0a, 0x00, 0x00, 0x00, 0x0c, 0x00, 0x00, 0x00,
+  0x80, 0x34, 0x83, 0x43, 0xfb, 0x81, 0xc1, 0x41, 0x0c, 0x3c, 0x6b, 0x43,
+  0x78, 0xb8, 0xdd, 0x41, 0x24, 0x2f, 0xd7, 0x41, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x00, 0x00, 0x78, 0xfe, 0xba, 0x41, 0x6b, 0x5a, 0x10, 0x43,
+  0x13, 0x50, 0xda, 0x42, 0x47, 0x4c, 0x0a, 0x43, 0xb1, 0xa9, 0x00, 0x43,
+  0x13, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0xf6, 0x75, 0xcf, 0x42,
+  0xe8, 0xc1, 0x5f, 0x43, 0xd9, 0x7c, 0x87, 0x42, 0x3e, 0x6a, 0x88, 0x43,
+  0x53, 0xb0, 0xab, 0x42, 0x11, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00,
+  0x60, 0x62, 0xd8, 0x42, 0x21, 0x7c, 0x19, 0x43, 0xf5, 0x75, 0xcf, 0x42,
+  0xe9, 0xc1, 0x5f, 0x43, 0x8b, 0x15, 0x6f, 0x42, 0x13, 0x00, 0x00, 0x00,
+  0x0e, 0x00, 0x00, 0x00, 0xb8, 0x94, 0xe8, 0x42, 0x4d, 0xa1, 0x4e, 0x43,
+  0xf6, 0x75, 0xcf, 0x42, 0xe8, 0xc1, 0x5f, 0x43, 0x79, 0x46, 0x9b, 0x42,
+  0x0d, 0x00, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00, 0xf5, 0x75, 0xcf, 0x42,
+  0xe9, 0xc1, 0x5f, 0x43, 0x60, 0x62, 0xd8, 0x42, 0x21, 0x7c, 0x19, 0x43,
+  0x8b, 0x15, 0x6f, 0x42, 0x11, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00,
+  0xf6, 0x75, 0xcf, 0x42, 0xe8, 0xc1, 0x5f, 0x43, 0xb8, 0x94, 0xe8, 0x42,
+  0x4d, 0xa1, 0x4e, 0x43, 0x79, 0x46, 0x9b, 0x42, 0x0d, 0x00, 0x00, 0x00,
+  0x0e, 0x00, 0x00, 0x00, 0xd9, 0x7c, 0x87, 0x42, 0x3e, 0x6a, 0x88, 0x43,
+  0xf6, 0x75, 0xcf, 0x42, 0xe8, 0xc1, 0x5f, 0x43, 0x53, 0xb0, 0xab, 0x42,
+  0x18, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x7f, 0xd0, 0xfb, 0x42,
+  0x5a, 0xcd, 0x5c, 0x43, 0x3b, 0x55, 0x23, 0x43, 0x5b, 0xfa, 0x89, 0x43,
+  0x8d, 0xa2, 0xb8, 0x42, 0x21, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x8e, 0xc8, 0x7c, 0x43, 0xd8, 0x28, 0x00, 0x43, 0x72, 0x6a, 0x7b, 0x43,
+  0x19, 0xee, 0x0e, 0x43, 0x4e, 0x79, 0xd1, 0x42, 0x24, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x72, 0x6a, 0x7b, 0x43, 0x19, 0xee, 0x0e, 0x43,
+  0xa1, 0x21, 0x75, 0x43, 0xbb, 0xcd, 0x52, 0x43, 0x51, 0xa8, 0x35, 0x42,
+  0x08, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0xcb, 0x55, 0x4a, 0x43,
+  0x7a, 0xb8, 0x03, 0x43, 0x8f, 0xc8, 0x7c, 0x43, 0xd8, 0x28, 0x00, 0x43,
+  0xea, 0xcc, 0x91, 0x42, 0x18, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+  0xa2, 0x21, 0x75, 0x43, 0xbb, 0xcd, 0x52, 0x43, 0xd0, 0x66, 0x64, 0x43,
+  0x86, 0xe3, 0x33, 0x43, 0xf0, 0x0d, 0xa1, 0x42, 0x24, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xa1, 0x21, 0x75, 0x43, 0xbb, 0xcd, 0x52, 0x43,
+  0x4b, 0x26, 0x72, 0x43, 0xf9, 0x01, 0x73, 0x43, 0x06, 0x65, 0x97, 0x42,
+  0x26, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x26, 0x72, 0x43,
+  0xf9, 0x01, 0x73, 0x43, 0xe4, 0x22, 0x72, 0x43, 0xba, 0x26, 0x73, 0x43,
+  0x11, 0x77, 0x63, 0x42, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xe4, 0x22, 0x72, 0x43, 0xba, 0x26, 0x73, 0x43, 0xcf, 0x24, 0x70, 0x43,
+  0xe0, 0x55, 0x84, 0x43, 0x07, 0xe7, 0xcf, 0x42, 0x13, 0x00, 0x00, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x3b, 0x55, 0x23, 0x43, 0x5b, 0xfa, 0x89, 0x43,
+  0x7f, 0xd0, 0xfb, 0x42, 0x5a, 0xcd, 0x5c, 0x43, 0x8d, 0xa2, 0xb8, 0x42,
+  0x17, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0xd0, 0x66, 0x64, 0x43,
+  0x86, 0xe3, 0x33, 0x43, 0xa2, 0x21, 0x75, 0x43, 0xbb, 0xcd, 0x52, 0x43,
+  0xf0, 0x0d, 0xa1, 0x42, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xcf, 0x24, 0x70, 0x43, 0xe0, 0x55, 0x84, 0x43, 0xe4, 0x22, 0x72, 0x43,
+  0xba, 0x26, 0x73, 0x43, 0x07, 0xe7, 0xcf, 0x42, 0x26, 0x00, 0x00, 0x00,
+  0x1c, 0x00, 0x00, 0x00, 0xe5, 0x22, 0x72, 0x43, 0xba, 0x26, 0x73, 0x43,
+  0x3e, 0xe3, 0x8b, 0x43, 0x4e, 0xa5, 0x71, 0x43, 0x94, 0x15, 0x3d, 0x42,
+  0x25, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x67, 0xb4, 0x9b, 0x43,
+  0x60, 0x61, 0x70, 0x43, 0x37, 0x4e, 0xb6, 0x43, 0x98, 0x40, 0x6e, 0x43,
+  0x1f, 0xb9, 0x1c, 0x42, 0x21, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00,
+  0x37, 0x4e, 0xb6, 0x43, 0x98, 0x40, 0x6e, 0x43, 0x02, 0x8d, 0xb8, 0x43,
+  0x9c, 0x12, 0x6e, 0x43, 0x5e, 0xbb, 0x97, 0x42, 0x1d, 0x00, 0x00, 0x00,
+  0x1d, 0x00, 0x00, 0x00, 0x7a, 0x4f, 0xb4, 0x43, 0x73, 0xf8, 0x76, 0x43,
+  0xcb, 0x77, 0x7e, 0x43, 0x81, 0x48, 0x83, 0x43, 0xee, 0x82, 0x9f, 0x41,
+  0x1b, 0x00, 0x00, 0x00, 0x1d, 0x00, 0x00, 0x00, 0xcb, 0x77, 0x7e, 0x43,
+  0x81, 0x48, 0x83, 0x43, 0x7a, 0x4f, 0xb4, 0x43, 0x73, 0xf8, 0x76, 0x43,
+  0xee, 0x82, 0x9f, 0x41, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x8e, 0xc8, 0x7c, 0x43, 0xd8, 0x28, 0x00, 0x43, 0xda, 0x7f, 0x80, 0x43,
+  0x80, 0x43, 0xa5, 0x42, 0x63, 0xcf, 0x20, 0x43, 0x17, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x72, 0x6a, 0x7b, 0x43, 0x19, 0xee, 0x0e, 0x43,
+  0x8e, 0xc8, 0x7c, 0x43, 0xd8, 0x28, 0x00, 0x43, 0x4e, 0x79, 0xd1, 0x42,
+  0x29, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x00, 0x00, 0xff, 0x86, 0x90, 0x43,
+  0x54, 0xc1, 0xcd, 0x42, 0x6c, 0x87, 0xbe, 0x43, 0x26, 0xfc, 0x20, 0x43,
+  0x16, 0x99, 0x69, 0x42, 0x1b, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00,
+  0x02, 0x8d, 0xb8, 0x43, 0x9c, 0x12, 0x6e, 0x43, 0x37, 0x4e, 0xb6, 0x43,
+  0x98, 0x40, 0x6e, 0x43, 0x5e, 0xbb, 0x97, 0x42, 0x25, 0x00, 0x00, 0x00,
+  0x22, 0x00, 0x00, 0x00, 0x37, 0x4e, 0xb6, 0x43, 0x98, 0x40, 0x6e, 0x43,
+  0xa5, 0x0b, 0xaa, 0x43, 0x95, 0x9a, 0x59, 0x43, 0x90, 0xc3, 0x51, 0x42,
+  0x27, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x47, 0x06, 0x9e, 0x43,
+  0xa7, 0x5b, 0x45, 0x43, 0x5f, 0x0c, 0x96, 0x43, 0xa7, 0xec, 0x37, 0x43,
+  0x9b, 0x41, 0x16, 0x42, 0x24, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,
+  0x5f, 0x0c, 0x96, 0x43, 0xa7, 0xec, 0x37, 0x43, 0x74, 0x6a, 0x7b, 0x43,
+  0x18, 0xee, 0x0e, 0x43, 0xda, 0x9f, 0x8f, 0x42, 0x17, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xa1, 0x21, 0x75, 0x43, 0xbb, 0xcd, 0x52, 0x43,
+  0x72, 0x6a, 0x7b, 0x43, 0x19, 0xee, 0x0e, 0x43, 0x51, 0xa8, 0x35, 0x42,
+  0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4b, 0x26, 0x72, 0x43,
+  0xf9, 0x01, 0x73, 0x43, 0xa1, 0x21, 0x75, 0x43, 0xbb, 0xcd, 0x52, 0x43,
+  0x06, 0x65, 0x97, 0x42, 0x21, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00,
+  0x74, 0x6a, 0x7b, 0x43, 0x18, 0xee, 0x0e, 0x43, 0x5f, 0x0c, 0x96, 0x43,
+  0xa7, 0xec, 0x37, 0x43, 0xda, 0x9f, 0x8f, 0x42, 0x27, 0x00, 0x00, 0x00,
+  0x25, 0x00, 0x00, 0x00, 0x5f, 0x0c, 0x96, 0x43, 0xa7, 0xec, 0x37, 0x43,
+  0x16, 0xd7, 0x8e, 0x43, 0x96, 0x9f, 0x46, 0x43, 0xc3, 0xd6, 0x10, 0x42,
+  0x26, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00, 0xa8, 0x15, 0x84, 0x43,
+  0x6c, 0x8e, 0x5c, 0x43, 0x4c, 0x26, 0x72, 0x43, 0xf8, 0x01, 0x73, 0x43,
+  0x0e, 0xea, 0x3e, 0x42, 0x1b, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00,
+  0x37, 0x4e, 0xb6, 0x43, 0x98, 0x40, 0x6e, 0x43, 0x67, 0xb4, 0x9b, 0x43,
+  0x60, 0x61, 0x70, 0x43, 0x1f, 0xb9, 0x1c, 0x42, 0x21, 0x00, 0x00, 0x00,
+  0x22, 0x00, 0x00, 0x00, 0xa5, 0x0b, 0xaa, 0x43, 0x95, 0x9a, 0x59, 0x43,
+  0x37, 0x4e, 0xb6, 0x43, 0x98, 0x40, 0x6e, 0x43, 0x90, 0xc3, 0x51, 0x42,
+  0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe4, 0x22, 0x72, 0x43,
+  0xba, 0x26, 0x73, 0x43, 0x4b, 0x26, 0x72, 0x43, 0xf9, 0x01, 0x73, 0x43,
+  0x11, 0x77, 0x63, 0x42, 0x1b, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00,
+  0x3e, 0xe3, 0x8b, 0x43, 0x4e, 0xa5, 0x71, 0x43, 0xe5, 0x22, 0x72, 0x43,
+  0xba, 0x26, 0x73, 0x43, 0x94, 0x15, 0x3d, 0x42, 0x24, 0x00, 0x00, 0x00,
+  0x25, 0x00, 0x00, 0x00, 0x4c, 0x26, 0x72, 0x43, 0xf8, 0x01, 0x73, 0x43,
+  0xa8, 0x15, 0x84, 0x43, 0x6c, 0x8e, 0x5c, 0x43, 0x0e, 0xea, 0x3e, 0x42,
+  0x21, 0x00, 0x00, 0x00, 0x22, 0x00, 0x00, 0x00, 0x5f, 0x0c, 0x96, 0x43,
+  0xa7, 0xec, 0x37, 0x43, 0x47, 0x06, 0x9e, 0x43, 0xa7, 0x5b, 0x45, 0x43,
+  0x9b, 0x41, 0x16, 0x42, 0x24, 0x00, 0x00, 0x00, 0x25, 0x00, 0x00, 0x00,
+  0x16, 0xd7, 0x8e, 0x43, 0x96, 0x9f, 0x46, 0x43, 0x5f, 0x0c, 0x96, 0x43,
+  0xa7, 0xec, 0x37, 0x43, 0xc3, 0xd6, 0x10, 0x42, 0x21, 0x00, 0x00, 0x00,
+  0x1b, 0x00, 0x00, 0x00, 0x6c, 0x87, 0xbe, 0x43, 0x26, 0xfc, 0x20, 0x43,
+  0xff, 0x86, 0x90, 0x43, 0x54, 0xc1, 0xcd, 0x42, 0x16, 0x99, 0x69, 0x42,
+  0x2d, 0x00, 0x00, 0x00, 0x2a, 0x00, 0x00, 0x00, 0xe7, 0x31, 0xa5, 0x43,
+  0x6a, 0x82, 0xb9, 0x42, 0xa3, 0x3f, 0xb5, 0x43, 0xc9, 0x58, 0xcb, 0x42,
+  0xbd, 0x53, 0x5c, 0x42, 0x2b, 0x00, 0x00, 0x00, 0x2b, 0x00, 0x00, 0x00,
+  0xa4, 0x3f, 0xb5, 0x43, 0xc8, 0x58, 0xcb, 0x42, 0x08, 0xa5, 0xb5, 0x43,
+  0x36, 0x49, 0xd0, 0x42, 0x15, 0x4b, 0xd9, 0x41, 0x2d, 0x00, 0x00, 0x00,
+  0x2a, 0x00, 0x00, 0x00, 0xa3, 0x3f, 0xb5, 0x43, 0xc9, 0x58, 0xcb, 0x42,
+  0x3f, 0xf4, 0xb5, 0x43, 0x77, 0x21, 0xcc, 0x42, 0xf1, 0x90, 0x0c, 0x42,
+  0x29, 0x00, 0x00, 0x00, 0x2b, 0x00, 0x00, 0x00, 0x08, 0xa5, 0xb5, 0x43,
+  0x36, 0x49, 0xd0, 0x42, 0xa4, 0x3f, 0xb5, 0x43, 0xc8, 0x58, 0xcb, 0x42,
+  0x15, 0x4b, 0xd9, 0x41, 0x31, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00,
+  0x47, 0x9e, 0xa7, 0x43, 0x5d, 0xc6, 0x77, 0x42, 0x22, 0xf3, 0xba, 0x43,
+  0xfc, 0x64, 0xdd, 0x41, 0xeb, 0x7b, 0x14, 0x42, 0x29, 0x00, 0x00, 0x00,
+  0x2a, 0x00, 0x00, 0x00, 0xa3, 0x3f, 0xb5, 0x43, 0xc9, 0x58, 0xcb, 0x42,
+  0xe7, 0x31, 0xa5, 0x43, 0x6a, 0x82, 0xb9, 0x42, 0xbd, 0x53, 0x5c, 0x42,
+  0x2b, 0x00, 0x00, 0x00, 0x2a, 0x00, 0x00, 0x00, 0x3f, 0xf4, 0xb5, 0x43,
+  0x77, 0x21, 0xcc, 0x42, 0xa3, 0x3f, 0xb5, 0x43, 0xc9, 0x58, 0xcb, 0x42,
+  0xf1, 0x90, 0x0c, 0x42, 0x2d, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00,
+  0x22, 0xf3, 0xba, 0x43, 0xfc, 0x64, 0xdd, 0x41, 0x47, 0x9e, 0xa7, 0x43,
+  0x5d, 0xc6, 0x77, 0x42, 0xeb, 0x7b, 0x14, 0x42, 0x34, 0x00, 0x00, 0x00,
+  0x31, 0x00, 0x00, 0x00, 0xbe, 0x25, 0xa8, 0x43, 0xcc, 0xdc, 0x5c, 0x42,
+  0xc9, 0x4d, 0xab, 0x43, 0xc0, 0x57, 0x71, 0x41, 0xd4, 0x09, 0x58, 0x42,
+  0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x34, 0x83, 0x43,
+  0xf8, 0x81, 0xc1, 0x41, 0x44, 0x59, 0x83, 0x43, 0x56, 0xb0, 0xa8, 0x41,
+  0x17, 0xc7, 0x43, 0x42, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xe7, 0x6c, 0x82, 0x43, 0x44, 0x1e, 0x24, 0x42, 0x7f, 0x34, 0x83, 0x43,
+  0xf8, 0x81, 0xc1, 0x41, 0x1f, 0x09, 0x91, 0x42, 0x31, 0x00, 0x00, 0x00,
+  0x31, 0x00, 0x00, 0x00, 0xc9, 0x4d, 0xab, 0x43, 0xc0, 0x57, 0x71, 0x41,
+  0xbe, 0x25, 0xa8, 0x43, 0xcc, 0xdc, 0x5c, 0x42, 0xd4, 0x09, 0x58, 0x42,
+  0x37, 0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x0f, 0x79, 0x8f, 0x43,
+  0xc6, 0xbe, 0x37, 0x42, 0xe8, 0x6c, 0x82, 0x43, 0x45, 0x1e, 0x24, 0x42,
+  0xb8, 0x25, 0x1c, 0x42, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0xe9, 0xd5, 0x81, 0x43, 0x52, 0x14, 0x57, 0x42, 0xe7, 0x6c, 0x82, 0x43,
+  0x44, 0x1e, 0x24, 0x42, 0x52, 0x80, 0x20, 0x42, 0x08, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0xca, 0x8d, 0x81, 0x43, 0xcf, 0x6b, 0x6f, 0x42,
+  0xe9, 0xd5, 0x81, 0x43, 0x52, 0x14, 0x57, 0x42, 0x9e, 0x15, 0xa0, 0x42,
+  0x34, 0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0xe8, 0x6c, 0x82, 0x43,
+  0x45, 0x1e, 0x24, 0x42, 0x0f, 0x79, 0x8f, 0x43, 0xc6, 0xbe, 0x37, 0x42,
+  0xb8, 0x25, 0x1c, 0x42
+};
+unsigned int test_map_navmesh_len = 3112;
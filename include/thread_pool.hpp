@@ -0,0 +1,198 @@
+#ifndef ALH_THREAD_POOL_HPP
+#define ALH_THREAD_POOL_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace alh {
+
+// fixed set of worker threads, the thread calling parallel_for or wait works too
+struct thread_pool_t {
+
+    // tasks spawned into a group, wait() returns when all of them have run
+    struct task_group_t {
+        std::atomic<size_t> pending{0};
+    };
+
+    explicit thread_pool_t(size_t n_threads = 0) : queues(n_threads ? n_threads : std::max(1u, std::thread::hardware_concurrency())) {
+        for (size_t i=1; i<queues.size(); i++)
+            workers.emplace_back([this, i]() { worker_loop(i); });
+    }
+
+    ~thread_pool_t() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            b_quit = true;
+        }
+        cv_work.notify_all();
+        for (std::thread &t : workers) t.join();
+    }
+
+    thread_pool_t(thread_pool_t const&) = delete;
+    thread_pool_t &operator=(thread_pool_t const&) = delete;
+
+    size_t size() const { return workers.size() + 1; }
+
+    // index of the calling thread below size(), 0 for threads outside this pool (also
+    // workers of another one, which run its parallel_for inline). lets parallel_for
+    // bodies pick per-thread scratch
+    size_t thread_index() const { return (this == t_pool) ? t_slot : 0; }
+
+    // run fn(begin, end) over [0, n) in chunks of at most grain items and wait
+    // for all of them. nested calls from inside fn run on the calling thread
+    void parallel_for(size_t n, size_t grain, std::function<void(size_t, size_t)> const& fn) {
+        assert(grain > 0);
+        if (n <= grain || workers.empty() || t_in_pool) {
+            for (size_t i=0; i<n; i+=grain) fn(i, std::min(i + grain, n));
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit(submit_mutex); // one job at a time
+        job.fn = &fn;
+        job.n = n;
+        job.grain = grain;
+        job.next.store(0);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job_id++;
+            n_busy = workers.size();
+        }
+        cv_work.notify_all();
+
+        t_in_pool = true;
+        run_chunks();
+        t_in_pool = false;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cv_done.wait(lock, [this]() { return 0 == n_busy; });
+    }
+
+    // queue fn on the calling thread's deque. idle threads steal from the other end,
+    // so large tasks spawned first are the ones that move. fn may spawn more tasks
+    void spawn(task_group_t &group, std::function<void()> fn) {
+        group.pending.fetch_add(1);
+        if (workers.empty()) {
+            fn();
+            group.pending.fetch_sub(1);
+            return;
+        }
+
+        task_queue_t &q = queues[thread_index()];
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back({&group, std::move(fn)});
+        }
+        n_queued.fetch_add(1);
+        { std::lock_guard<std::mutex> lock(mutex); } // no lost wakeup between check and wait
+        cv_work.notify_one();
+    }
+
+    // run queued tasks (own first, then stolen) until the group is done
+    void wait(task_group_t &group) {
+        while (group.pending.load() > 0) {
+            if (!run_task()) std::this_thread::yield();
+        }
+    }
+
+private:
+
+    struct job_t {
+        std::function<void(size_t, size_t)> const* fn;
+        size_t n, grain;
+        std::atomic<size_t> next;
+    };
+
+    struct task_t {
+        task_group_t *group;
+        std::function<void()> fn;
+    };
+
+    struct task_queue_t {
+        std::mutex mutex;
+        std::deque<task_t> tasks;
+    };
+
+    // newest task of this thread's queue, else the oldest of another one
+    bool run_task() {
+        if (0 == n_queued.load()) return false;
+
+        size_t self = thread_index();
+        task_t task;
+        bool b_found = false;
+        for (size_t k=0; k<queues.size() && !b_found; k++) {
+            task_queue_t &q = queues[(self + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) continue;
+            if (0 == k) {
+                task = std::move(q.tasks.back());
+                q.tasks.pop_back();
+            } else {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+            }
+            b_found = true;
+        }
+        if (!b_found) return false;
+
+        n_queued.fetch_sub(1);
+        task.fn();
+        task.group->pending.fetch_sub(1);
+        return true;
+    }
+
+    void run_chunks() {
+        for (size_t i; (i = job.next.fetch_add(job.grain)) < job.n;)
+            (*job.fn)(i, std::min(i + job.grain, job.n));
+    }
+
+    void worker_loop(size_t slot) {
+        t_in_pool = true;
+        t_pool = this;
+        t_slot = slot;
+        uint64_t seen = 0;
+        for (;;) {
+            if (run_task()) continue;
+
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv_work.wait(lock, [&]() { return b_quit || job_id != seen || n_queued.load() > 0; });
+                if (b_quit) return;
+                if (job_id == seen) continue; // woken for a task
+                seen = job_id;
+            }
+
+            run_chunks();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (0 == --n_busy) cv_done.notify_one();
+        }
+    }
+
+    std::vector<task_queue_t> queues; // one per thread, 0 is for outside callers
+    std::atomic<size_t> n_queued{0};
+    std::vector<std::thread> workers;
+    std::mutex submit_mutex;
+    std::mutex mutex;
+    std::condition_variable cv_work, cv_done;
+    job_t job;
+    uint64_t job_id = 0;
+    size_t n_busy = 0;
+    bool b_quit = false;
+
+    static inline thread_local bool t_in_pool = false;
+    static inline thread_local thread_pool_t const* t_pool = nullptr; // set for workers
+    static inline thread_local size_t t_slot = 0; // in t_pool
+};
+
+} // namespace alh
+
+#endif
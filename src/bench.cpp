@@ -0,0 +1,832 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <new>
+#include <atomic>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
+
+#include "bsp.hpp"
+#include "bsp_stl.hpp"
+#include "navmesh.hpp"
+#include "thread_pool.hpp"
+
+#include "test.stl.h"
+
+using namespace alh;
+
+// headless benchmark for the bsp and navmesh entry points
+//
+// usage: bench [--sizes 1000,10000,...] [--maps rooms,maze,scatter,stl,stlgrid]
+//              [--queries N] [--reps N] [--seed N]
+//              [--max-csg N] [--max-navmesh N] [--heuristic mean|cost]
+//
+// tree shape of each build (depth, nodes, leaves, splits) goes to stderr
+
+namespace {
+
+// track heap usage by overriding the global allocator
+
+std::atomic<size_t> g_heap_current{0};
+std::atomic<size_t> g_heap_peak{0};
+
+struct alloc_header_t {
+    size_t size;
+    size_t pad; // keep payload 16-byte aligned
+};
+
+void count_alloc(size_t size) {
+    size_t cur = g_heap_current.fetch_add(size) + size;
+    size_t peak = g_heap_peak.load();
+    while (cur > peak && !g_heap_peak.compare_exchange_weak(peak, cur));
+}
+
+void *tracked_alloc(size_t size) {
+    void *p = std::malloc(size + sizeof(alloc_header_t));
+    if (!p) throw std::bad_alloc();
+    ((alloc_header_t *)p)->size = size;
+    count_alloc(size);
+    return (alloc_header_t *)p + 1;
+}
+
+void tracked_free(void *p) {
+    if (!p) return;
+    alloc_header_t *h = (alloc_header_t *)p - 1;
+    g_heap_current.fetch_sub(h->size);
+    std::free(h);
+}
+
+// over-aligned allocations, which std::pmr::new_delete_resource() makes for all of
+// them. the header sits right before the payload and keeps the malloc'd block
+struct aligned_header_t {
+    void *block;
+    size_t size;
+};
+
+void *tracked_alloc(size_t size, std::align_val_t align) {
+    size_t a = std::max((size_t)align, alignof(aligned_header_t));
+    void *block = std::malloc(size + a + sizeof(aligned_header_t));
+    if (!block) throw std::bad_alloc();
+    uintptr_t payload = ((uintptr_t)block + sizeof(aligned_header_t) + a - 1) & ~(uintptr_t)(a - 1);
+    aligned_header_t *h = (aligned_header_t *)payload - 1;
+    h->block = block;
+    h->size = size;
+    count_alloc(size);
+    return (void *)payload;
+}
+
+void tracked_free(void *p, std::align_val_t) {
+    if (!p) return;
+    aligned_header_t *h = (aligned_header_t *)p - 1;
+    g_heap_current.fetch_sub(h->size);
+    std::free(h->block);
+}
+
+} // namespace
+
+void *operator new(size_t size) { return tracked_alloc(size); }
+void *operator new[](size_t size) { return tracked_alloc(size); }
+void operator delete(void *p) noexcept { tracked_free(p); }
+void operator delete[](void *p) noexcept { tracked_free(p); }
+void operator delete(void *p, size_t) noexcept { tracked_free(p); }
+void operator delete[](void *p, size_t) noexcept { tracked_free(p); }
+void *operator new(size_t size, std::align_val_t align) { return tracked_alloc(size, align); }
+void *operator new[](size_t size, std::align_val_t align) { return tracked_alloc(size, align); }
+void operator delete(void *p, std::align_val_t align) noexcept { tracked_free(p, align); }
+void operator delete[](void *p, std::align_val_t align) noexcept { tracked_free(p, align); }
+void operator delete(void *p, size_t, std::align_val_t align) noexcept { tracked_free(p, align); }
+void operator delete[](void *p, size_t, std::align_val_t align) noexcept { tracked_free(p, align); }
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct options_t {
+    std::vector<size_t> sizes = {1000, 10000, 100000};
+    std::vector<std::string> maps = {"rooms", "maze", "scatter", "stl"};
+    size_t queries = 20000;
+    size_t reps = 3;
+    size_t max_csg = 2000;
+    size_t max_navmesh = 100000;
+    uint32_t seed = 1234;
+    bsp::build_options_t build;
+};
+
+struct result_t {
+    std::vector<double> samples_ns; // one sample per call
+    size_t peak_bytes;
+};
+
+void report(char const* map, size_t n_segments, char const* op, result_t &r) {
+    assert(!r.samples_ns.empty());
+    std::sort(r.samples_ns.begin(), r.samples_ns.end());
+
+    double total = 0.0;
+    for (double s : r.samples_ns) total += s;
+
+    auto pct = [&](double p) {
+        size_t i = std::min(r.samples_ns.size() - 1, (size_t)(p * r.samples_ns.size()));
+        return r.samples_ns[i];
+    };
+
+    printf("%-8s %9zu  %-14s %9zu %14.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n",
+           map, n_segments, op, r.samples_ns.size(),
+           r.samples_ns.size() / (total * 1e-9),
+           pct(0.5) * 1e-3, pct(0.9) * 1e-3, pct(0.99) * 1e-3, r.samples_ns.back() * 1e-3,
+           r.peak_bytes / 1024.0);
+    fflush(stdout);
+}
+
+// measure each call of fn(i) for i in [0, n) separately
+result_t measure(size_t n, std::function<void(size_t)> const& fn) {
+    result_t r;
+    r.samples_ns.reserve(n);
+
+    size_t base = g_heap_current.load();
+    g_heap_peak.store(base);
+
+    for (size_t i=0; i<n; i++) {
+        auto t0 = clock_type::now();
+        fn(i);
+        auto t1 = clock_type::now();
+        r.samples_ns.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+    }
+
+    r.peak_bytes = g_heap_peak.load() - base;
+    return r;
+}
+
+// map generators
+//
+// empty space is to the right of a line (counter-clockwise outer boundary),
+// solid space to the left (clockwise obstacles), same as the .stl import
+
+void push_box(std::vector<line_t> &lines, vec2_t min, vec2_t max, bool solid) {
+    vec2_t a = {min.x, min.y}, b = {max.x, min.y}, c = {max.x, max.y}, d = {min.x, max.y};
+    if (solid) {
+        lines.push_back({a, d});
+        lines.push_back({d, c});
+        lines.push_back({c, b});
+        lines.push_back({b, a});
+    } else {
+        lines.push_back({a, b});
+        lines.push_back({b, c});
+        lines.push_back({c, d});
+        lines.push_back({d, a});
+    }
+}
+
+// grid of rooms separated by walls with a door in the middle of each wall
+std::vector<line_t> gen_rooms(size_t n_segments, std::mt19937 &) {
+    // each room adds two walls, each wall is two boxes (8 segments per wall)
+    size_t g = std::max<size_t>(2, (size_t)sqrtf(n_segments / 16.f));
+    float cell = 40.f, wall = 2.f, door = 12.f, corner = 3.f;
+
+    std::vector<line_t> lines;
+    lines.reserve(g * g * 16 + 4);
+    push_box(lines, {0.f, 0.f}, {g * cell, g * cell}, false);
+
+    for (size_t y=0; y<g; y++) {
+        for (size_t x=0; x<g; x++) {
+            float x0 = x * cell, y0 = y * cell;
+            float half = (cell - door) / 2.f;
+            if (x + 1 < g) { // vertical wall on the right side of the room
+                float wx = x0 + cell - wall / 2.f;
+                push_box(lines, {wx, y0 + corner}, {wx + wall, y0 + half}, true);
+                push_box(lines, {wx, y0 + cell - half}, {wx + wall, y0 + cell - corner}, true);
+            }
+            if (y + 1 < g) { // horizontal wall below the room
+                float wy = y0 + cell - wall / 2.f;
+                push_box(lines, {x0 + corner, wy}, {x0 + half, wy + wall}, true);
+                push_box(lines, {x0 + cell - half, wy}, {x0 + cell - corner, wy + wall}, true);
+            }
+        }
+    }
+
+    return lines;
+}
+
+// depth-first maze, remaining walls are boxes that don't touch at the corners
+std::vector<line_t> gen_maze(size_t n_segments, std::mt19937 &rng) {
+    size_t g = std::max<size_t>(2, (size_t)sqrtf(n_segments / 4.f));
+    float cell = 20.f, wall = 2.f, corner = 2.f;
+
+    // walls[2*i] is the right wall of cell i, walls[2*i+1] the bottom wall
+    std::vector<bool> walls(g * g * 2, true);
+    std::vector<bool> visited(g * g, false);
+    std::vector<size_t> stack = {0};
+    visited[0] = true;
+
+    while (!stack.empty()) {
+        size_t i = stack.back();
+        size_t x = i % g, y = i / g;
+
+        size_t next[4];
+        size_t n_next = 0;
+        if (x > 0 && !visited[i - 1]) next[n_next++] = i - 1;
+        if (x + 1 < g && !visited[i + 1]) next[n_next++] = i + 1;
+        if (y > 0 && !visited[i - g]) next[n_next++] = i - g;
+        if (y + 1 < g && !visited[i + g]) next[n_next++] = i + g;
+
+        if (0 == n_next) {
+            stack.pop_back();
+            continue;
+        }
+
+        size_t j = next[rng() % n_next];
+        if (j == i + 1) walls[2*i] = false;
+        if (j + 1 == i) walls[2*j] = false;
+        if (j == i + g) walls[2*i+1] = false;
+        if (j + g == i) walls[2*j+1] = false;
+        visited[j] = true;
+        stack.push_back(j);
+    }
+
+    std::vector<line_t> lines;
+    push_box(lines, {0.f, 0.f}, {g * cell, g * cell}, false);
+    for (size_t i=0; i<g*g; i++) {
+        size_t x = i % g, y = i / g;
+        float x0 = x * cell, y0 = y * cell;
+        if (x + 1 < g && walls[2*i]) {
+            float wx = x0 + cell - wall / 2.f;
+            push_box(lines, {wx, y0 + corner}, {wx + wall, y0 + cell - corner}, true);
+        }
+        if (y + 1 < g && walls[2*i+1]) {
+            float wy = y0 + cell - wall / 2.f;
+            push_box(lines, {x0 + corner, wy}, {x0 + cell - corner, wy + wall}, true);
+        }
+    }
+
+    return lines;
+}
+
+// random convex obstacles on a jittered grid
+std::vector<line_t> gen_scatter(size_t n_segments, std::mt19937 &rng) {
+    size_t g = std::max<size_t>(2, (size_t)sqrtf(n_segments / 5.f));
+    float cell = 40.f;
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+
+    std::vector<line_t> lines;
+    push_box(lines, {0.f, 0.f}, {g * cell, g * cell}, false);
+
+    for (size_t y=0; y<g; y++) {
+        for (size_t x=0; x<g; x++) {
+            size_t n_verts = 3 + rng() % 5;
+            float r = cell * (0.15f + 0.15f * unit(rng));
+            vec2_t c = {(x + 0.5f) * cell + (unit(rng) - 0.5f) * cell * 0.2f,
+                        (y + 0.5f) * cell + (unit(rng) - 0.5f) * cell * 0.2f};
+            float a0 = unit(rng) * 6.2831853f;
+
+            // clockwise polygon => solid inside
+            std::vector<vec2_t> verts;
+            for (size_t k=0; k<n_verts; k++) {
+                float a = a0 - k * 6.2831853f / n_verts;
+                verts.push_back({c.x + r * cosf(a), c.y + r * sinf(a)});
+            }
+            for (size_t k=0; k<n_verts; k++)
+                lines.push_back({verts[k], verts[(k + 1) % n_verts]});
+        }
+    }
+
+    return lines;
+}
+
+// binary .stl of a floor plan: unit squares as two triangles each, with random
+// squares left out as pillars. n_tris is the triangle count
+std::vector<uint8_t> gen_stl_grid(size_t n_tris, std::mt19937 &rng) {
+    size_t g = std::max<size_t>(2, (size_t)sqrtf(n_tris / 2.f));
+    float cell = 4.f;
+
+    std::vector<uint8_t> out(84, 0);
+    uint32_t n = 0;
+    auto push_tri = [&](vec2_t a, vec2_t b, vec2_t c) {
+        float rec[12] = {0.f, 0.f, 1.f, a.x, a.y, 0.f, b.x, b.y, 0.f, c.x, c.y, 0.f};
+        uint8_t bytes[50] = {};
+        memcpy(bytes, rec, sizeof(rec));
+        out.insert(out.end(), bytes, bytes + 50);
+        n++;
+    };
+
+    for (size_t y=0; y<g; y++) {
+        for (size_t x=0; x<g; x++) {
+            bool b_border = (0 == x || 0 == y || g - 1 == x || g - 1 == y);
+            if (!b_border && 0 == rng() % 16) continue; // pillar
+            vec2_t p = {x * cell, y * cell};
+            push_tri(p, p + vec2_t{cell, 0.f}, p + vec2_t{cell, cell});
+            push_tri(p, p + vec2_t{cell, cell}, p + vec2_t{0.f, cell});
+        }
+    }
+
+    memcpy(out.data() + 80, &n, 4);
+    return out;
+}
+
+thread_pool_t &pool() {
+    static thread_pool_t p;
+    return p;
+}
+
+std::vector<vec2_t> random_points(bsp::bsp_t const& bsp, vec2_t min, vec2_t max, size_t n, bool empty_only, std::mt19937 &rng) {
+    std::uniform_real_distribution<float> dx(min.x, max.x), dy(min.y, max.y);
+    std::vector<vec2_t> points;
+    points.reserve(n);
+    for (size_t tries=0; points.size() < n && tries < n * 100; tries++) {
+        vec2_t p = {dx(rng), dy(rng)};
+        if (!empty_only || !bsp::is_solid(bsp, 0, p)) points.push_back(p);
+    }
+    return points;
+}
+
+void run_map(options_t const& opt, char const* name, std::vector<line_t> const& lines, bsp::bsp_t bsp, std::mt19937 &rng) {
+    size_t n = lines.empty() ? bsp.size() : lines.size();
+
+    if (!lines.empty()) {
+        bsp::build_stats_t stats;
+        result_t r = measure(opt.reps, [&](size_t) { bsp = bsp::build(lines, opt.build, &stats); });
+        report(name, n, "build", r);
+        fprintf(stderr, "%-8s %9zu  depth %u nodes %u leaves %u splits %u\n",
+                name, n, stats.depth, stats.node_count, stats.leaf_count, stats.splits);
+        bsp::tree_stats_t shape = bsp::tree_stats(bsp);
+        fprintf(stderr, "%-8s %9zu  mean depth %.1f solid %u empty %u kb %.1f\n",
+                name, n, shape.mean_depth, shape.solid_leaves, shape.empty_leaves, shape.bytes / 1024.0);
+
+        bsp::build_options_t options = opt.build;
+        options.pool = &pool();
+        r = measure(opt.reps, [&](size_t) { bsp = bsp::build(lines, options); });
+        report(name, n, "build_mt", r);
+
+        // tree and scratch from an arena that is dropped after each build
+        bsp::counting_resource_t counter;
+        options = opt.build;
+        options.memory = &counter;
+        r = measure(opt.reps, [&](size_t) {
+            std::pmr::monotonic_buffer_resource arena(&counter);
+            bsp::build_options_t arena_options = opt.build;
+            arena_options.memory = &arena;
+            bsp::bsp_t out = bsp::build(lines, arena_options);
+        });
+        report(name, n, "build_arena", r);
+        counter.reset();
+        { bsp::bsp_t out = bsp::build(lines, options); }
+        fprintf(stderr, "%-8s %9zu  build allocs %zu bytes %zu peak %zu\n", name, n, counter.n_allocs, counter.bytes, counter.peak);
+    }
+
+    {
+        std::vector<uint8_t> blob;
+        result_t r = measure(opt.reps, [&](size_t) { blob = bsp::serialize(bsp); });
+        report(name, n, "serialize", r);
+
+        r = measure(opt.reps, [&](size_t) { bsp::bsp_t out = bsp::deserialize(blob.data(), blob.size()); });
+        report(name, n, "deserialize", r);
+    }
+
+    vec2_t min, max;
+    bsp::navmesh::bsp_bb(bsp, min, max);
+
+    std::vector<vec2_t> points = random_points(bsp, min, max, opt.queries, false, rng);
+    std::vector<vec2_t> free_points = random_points(bsp, min, max, opt.queries, true, rng);
+    if (free_points.empty()) return;
+
+    {
+        volatile size_t acc = 0;
+        result_t r = measure(points.size(), [&](size_t i) { acc = acc + bsp::is_solid(bsp, 0, points[i]); });
+        report(name, n, "is_solid", r);
+    }
+
+    {
+        volatile size_t acc = 0;
+        result_t r = measure(points.size(), [&](size_t i) { acc = acc + bsp::leaf_id(bsp, 0, points[i]); });
+        report(name, n, "leaf_id", r);
+    }
+
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+    {
+        // agents move in groups, one call classifies a group of 64
+        constexpr size_t group = 64;
+        std::vector<vec2_t> agents;
+        agents.reserve(points.size());
+        for (size_t i=0; i + group <= points.size(); i+=group) {
+            for (size_t k=0; k<group; k++) agents.push_back(points[i] + vec2_t{unit(rng), unit(rng)} * 8.f);
+        }
+
+        std::vector<uint8_t> solid(group);
+        std::vector<bsp::id_t> ids(group);
+        std::span<vec2_t const> all = agents;
+
+        result_t r = measure(agents.size() / group, [&](size_t i) {
+            bsp::classify_points(bsp, all.subspan(i * group, group), solid, ids);
+        });
+        report(name, n, "classify_x64", r);
+
+        // the same groups one point at a time
+        r = measure(agents.size() / group, [&](size_t i) {
+            for (size_t k=0; k<group; k++) {
+                solid[k] = bsp::is_solid(bsp, 0, all[i * group + k]);
+                ids[k] = bsp::leaf_id(bsp, 0, all[i * group + k]);
+            }
+        });
+        report(name, n, "point_x64", r);
+    }
+
+    // sweeps of up to a tenth of the map extent from empty space
+    float reach = std::max(max.x - min.x, max.y - min.y) * 0.1f;
+    std::vector<line_t> rays;
+    rays.reserve(free_points.size());
+    for (vec2_t p : free_points) {
+        vec2_t q = p + vec2_t{unit(rng), unit(rng)} * reach;
+        if (p != q) rays.push_back({p, q});
+    }
+
+    {
+        volatile size_t acc = 0;
+        result_t r = measure(rays.size(), [&](size_t i) {
+            vec2_t v;
+            line_t l;
+            acc = acc + bsp::sweep(bsp, rays[i], v, l);
+        });
+        report(name, n, "sweep", r);
+    }
+
+    {
+        // the same points and sweeps on the fixed point copy of the tree
+        bsp::fixed_bsp_t fixed = bsp::to_fixed(bsp);
+        std::vector<vec2i_t> fixed_points;
+        fixed_points.reserve(points.size());
+        for (vec2_t p : points) fixed_points.push_back(bsp::to_fixed(p));
+        std::vector<vec2i_t> fixed_rays;
+        fixed_rays.reserve(rays.size() * 2);
+        for (line_t const& l : rays) {
+            fixed_rays.push_back(bsp::to_fixed(l.p));
+            fixed_rays.push_back(bsp::to_fixed(l.q));
+        }
+
+        volatile size_t acc = 0;
+        result_t r = measure(fixed_points.size(), [&](size_t i) { acc = acc + bsp::is_solid(fixed, 0, fixed_points[i]); });
+        report(name, n, "fixed_is_solid", r);
+
+        r = measure(rays.size(), [&](size_t i) {
+            vec2i_t v;
+            bsp::id_t nid;
+            acc = acc + bsp::sweep(fixed, fixed_rays[2 * i], fixed_rays[2 * i + 1], v, nid);
+        });
+        report(name, n, "fixed_sweep", r);
+    }
+
+    {
+        // line of sight between far apart free points, without and with node bounds
+        bsp::bsp_t bounded = bsp;
+        bsp::compute_bounds(bounded);
+        std::vector<line_t> los;
+        los.reserve(free_points.size());
+        for (size_t i=0; i<free_points.size(); i++) {
+            vec2_t q = free_points[(i * 7919 + 13) % free_points.size()];
+            if (free_points[i] != q) los.push_back({free_points[i], q});
+        }
+
+        volatile size_t acc = 0;
+        result_t r = measure(los.size(), [&](size_t i) {
+            vec2_t v;
+            line_t l;
+            acc = acc + bsp::sweep(bsp, los[i], v, l);
+        });
+        report(name, n, "sweep_long", r);
+
+        r = measure(los.size(), [&](size_t i) {
+            vec2_t v;
+            line_t l;
+            acc = acc + bsp::sweep(bounded, los[i], v, l);
+        });
+        report(name, n, "sweep_long_bounds", r);
+
+        std::vector<bsp::sweep_hit_t> hits(los.size());
+        r = measure(opt.reps, [&](size_t) { bsp::sweep_many(bsp, los, hits); });
+        report(name, n, "sweep_many_long", r);
+
+        r = measure(opt.reps, [&](size_t) { bsp::sweep_many(bounded, los, hits); });
+        report(name, n, "sweep_many_long_bounds", r);
+    }
+
+    {
+        // line of sight from groups of 64 agents to a shared target, 1024 rays per call
+        constexpr size_t group = 64, batch = 1024;
+        std::vector<line_t> los;
+        los.reserve(free_points.size());
+        for (size_t i=0; i + group <= free_points.size(); i+=group) {
+            vec2_t target = free_points[i] + vec2_t{unit(rng), unit(rng)} * reach;
+            for (size_t k=0; k<group; k++) {
+                vec2_t p = free_points[i] + vec2_t{unit(rng), unit(rng)} * 8.f;
+                if (p != target) los.push_back({p, target});
+            }
+        }
+
+        std::vector<bsp::sweep_hit_t> hits(los.size());
+        std::span<line_t const> all_los = los;
+        std::span<bsp::sweep_hit_t> all_hits = hits;
+
+        result_t r = measure(los.size() / batch, [&](size_t i) {
+            bsp::sweep_many(bsp, all_los.subspan(i * batch, batch), all_hits.subspan(i * batch, batch));
+        });
+        if (!r.samples_ns.empty()) report(name, n, "sweep_many_x1k", r);
+
+        r = measure(los.size() / batch, [&](size_t i) {
+            for (size_t k=i*batch; k<(i+1)*batch; k++)
+                hits[k].hit = bsp::sweep(bsp, los[k], hits[k].point, hits[k].plane);
+        });
+        if (!r.samples_ns.empty()) report(name, n, "sweep_x1k", r);
+
+        r = measure(opt.reps, [&](size_t) { bsp::sweep_many(bsp, all_los, all_hits, &pool()); });
+        report(name, n, "sweep_many_mt", r);
+    }
+
+    {
+        // short moves, like a character controller
+        std::vector<vec2_t> moves;
+        moves.reserve(free_points.size());
+        for (vec2_t p : free_points) moves.push_back(p + vec2_t{unit(rng), unit(rng)} * 4.f);
+
+        result_t r = measure(free_points.size(), [&](size_t i) {
+            vec2_t p2 = moves[i];
+            bsp::dot_solve(bsp, free_points[i], p2);
+        });
+        report(name, n, "dot_solve", r);
+
+        std::vector<bsp::move_result_t> results(moves.size());
+        r = measure(opt.reps, [&](size_t) { bsp::slide_move_many(bsp, free_points, moves, results); });
+        report(name, n, "slide_move_many", r);
+
+        r = measure(opt.reps, [&](size_t) { bsp::slide_move_many(bsp, free_points, moves, results, &pool()); });
+        report(name, n, "slide_move_many_mt", r);
+    }
+
+    {
+        // doors: a small box put down and taken away again at empty points
+        bsp::bsp_t edited = bsp;
+        std::vector<bsp::id_t> changed;
+        size_t n_doors = std::min<size_t>(free_points.size(), 256);
+        auto door = [&](size_t i) {
+            vec2_t c = free_points[i];
+            float s = reach * 0.02f;
+            return std::array<vec2_t, 4>{c + vec2_t{-s, -s}, c + vec2_t{s, -s}, c + vec2_t{s, s}, c + vec2_t{-s, s}};
+        };
+
+        result_t r_insert = {}, r_remove = {};
+        for (size_t i=0; i<n_doors; i++) {
+            std::array<vec2_t, 4> poly = door(i);
+            result_t r = measure(1, [&](size_t) { bsp::insert_obstacle(edited, poly, changed); });
+            r_insert.samples_ns.push_back(r.samples_ns[0]);
+            r_insert.peak_bytes = std::max(r_insert.peak_bytes, r.peak_bytes);
+            r = measure(1, [&](size_t) { bsp::remove_obstacle(edited, poly, changed); });
+            r_remove.samples_ns.push_back(r.samples_ns[0]);
+            r_remove.peak_bytes = std::max(r_remove.peak_bytes, r.peak_bytes);
+        }
+        report(name, n, "insert_obstacle", r_insert);
+        report(name, n, "remove_obstacle", r_remove);
+    }
+
+    if (n <= opt.max_csg) {
+        // second operand is the same map shifted by a fraction of a cell
+        bsp::bsp_t shifted;
+        if (!lines.empty()) {
+            std::vector<line_t> moved = lines;
+            vec2_t offset = {7.3f, 3.1f};
+            for (line_t &l : moved) {
+                l.p = l.p + offset;
+                l.q = l.q + offset;
+            }
+            shifted = bsp::build(moved);
+        } else {
+            shifted = bsp;
+        }
+
+        struct { char const* name; bsp::bsp_t (*fn)(bsp::bsp_t const&, bsp::bsp_t const&, std::pmr::memory_resource *); } ops[] = {
+            {"union_op", bsp::union_op},
+            {"intersect_op", bsp::intersect_op},
+            {"difference_op", bsp::difference_op},
+            {"xor_op", bsp::xor_op},
+        };
+
+        // flatten a tree rebuilt from its boundary, the depth it ends up at goes to stderr
+        bsp::build_options_t options = opt.build;
+        if (0 == options.max_depth) options.max_depth = std::bit_width(n) + 4;
+        bsp::build_stats_t stats;
+        result_t r_rebalance = measure(opt.reps, [&](size_t) { bsp::bsp_t out = bsp::rebalance(bsp, options, &stats); });
+        report(name, n, "rebalance", r_rebalance);
+        fprintf(stderr, "%-8s %9zu  rebalance depth %u nodes %u balanced %u\n", name, n, stats.depth, stats.node_count, stats.balanced);
+
+        for (auto const& op : ops) {
+            result_t r = measure(opt.reps, [&](size_t) { bsp::bsp_t out = op.fn(bsp, shifted, nullptr); });
+            report(name, n, op.name, r);
+
+            bsp::counting_resource_t counter;
+            r = measure(opt.reps, [&](size_t) {
+                std::pmr::monotonic_buffer_resource arena(&counter);
+                bsp::bsp_t out = op.fn(bsp, shifted, &arena);
+            });
+            std::string arena_name = std::string(op.name) + "_arena";
+            report(name, n, arena_name.c_str(), r);
+            counter.reset();
+            { bsp::bsp_t out = op.fn(bsp, shifted, &counter); }
+            fprintf(stderr, "%-8s %9zu  %s allocs %zu bytes %zu peak %zu\n", name, n, op.name, counter.n_allocs, counter.bytes, counter.peak);
+        }
+
+        // prefab stamps: small solid boxes over the map, all at once and one by one
+        std::vector<bsp::bsp_t> stamps;
+        for (size_t i=0; i<256 && i<free_points.size(); i++) {
+            std::vector<line_t> box;
+            vec2_t c = free_points[i];
+            push_box(box, c - vec2_t{2.f, 2.f}, c + vec2_t{2.f, 2.f}, true);
+            stamps.push_back(bsp::build(box));
+        }
+
+        result_t r = measure(opt.reps, [&](size_t) { bsp::bsp_t out = bsp::union_all(stamps); });
+        report(name, n, "union_all", r);
+
+        r = measure(opt.reps, [&](size_t) { bsp::bsp_t out = bsp::union_all(stamps, &pool()); });
+        report(name, n, "union_all_mt", r);
+
+        r = measure(opt.reps, [&](size_t) {
+            bsp::bsp_t out = stamps[0];
+            for (size_t i=1; i<stamps.size(); i++) out = bsp::union_op(out, stamps[i]);
+        });
+        report(name, n, "union_fold", r);
+    }
+
+    if (n <= opt.max_navmesh) {
+        bsp::navmesh::navmesh_t navmesh;
+        result_t r = measure(opt.reps, [&](size_t) { navmesh = bsp::navmesh::build(bsp); });
+        report(name, n, "navmesh_build", r);
+
+        // random pairs across the whole map,
+        // only keep pairs that have a route, find_path expects one
+        std::vector<std::pair<vec2_t, vec2_t>> pairs;
+        size_t n_pairs = std::min<size_t>(opt.queries / 10 + 1, free_points.size() / 2);
+        for (size_t i=0; i<n_pairs; i++) {
+            vec2_t a = free_points[2*i];
+            vec2_t b = free_points[2*i + 1];
+            if (bsp::leaf_id(bsp, 0, a) == bsp::leaf_id(bsp, 0, b) ||
+                !bsp::navmesh::astar(bsp, navmesh, a, b).empty())
+                pairs.push_back({a, b});
+        }
+
+        if (!pairs.empty()) {
+            volatile size_t acc = 0;
+            result_t r = measure(pairs.size(), [&](size_t i) {
+                acc = acc + bsp::navmesh::find_path(bsp, navmesh, pairs[i].first, pairs[i].second).size();
+            });
+            report(name, n, "find_path", r);
+
+            // same queries through one reused context, allocation free once warm
+            bsp::navmesh::path_query_context_t ctx;
+            std::vector<vec2_t> points;
+            for (auto const& pair : pairs) bsp::navmesh::find_path(bsp, navmesh, pair.first, pair.second, ctx, points);
+            r = measure(pairs.size(), [&](size_t i) {
+                bsp::navmesh::find_path(bsp, navmesh, pairs[i].first, pairs[i].second, ctx, points);
+                acc = acc + points.size();
+            });
+            report(name, n, "find_path_ctx", r);
+
+            // same queries through the abstract graph
+            bsp::navmesh::hpa_t hpa;
+            r = measure(opt.reps, [&](size_t) { hpa = bsp::navmesh::build_hpa(navmesh); });
+            report(name, n, "hpa_build", r);
+            for (auto const& pair : pairs) bsp::navmesh::find_path(bsp, navmesh, hpa, pair.first, pair.second, ctx, points);
+            r = measure(pairs.size(), [&](size_t i) {
+                bsp::navmesh::find_path(bsp, navmesh, hpa, pairs[i].first, pairs[i].second, ctx, points);
+                acc = acc + points.size();
+            });
+            report(name, n, "find_path_hpa", r);
+
+            // all queries as one batch, like a wave of agents asking in the same frame
+            std::vector<bsp::navmesh::path_query_t> queries;
+            for (auto const& pair : pairs) queries.push_back({pair.first, pair.second});
+            bsp::navmesh::path_batch_t batch;
+            r = measure(opt.reps, [&](size_t) { bsp::navmesh::find_paths(bsp, navmesh, &hpa, queries, batch); });
+            report(name, n, "find_paths", r);
+            r = measure(opt.reps, [&](size_t) { bsp::navmesh::find_paths(bsp, navmesh, &hpa, queries, batch, &pool()); });
+            report(name, n, "find_paths_mt", r);
+
+            // one goal shared by all agents, a search per goal and a lookup per agent
+            bsp::navmesh::flow_field_t field;
+            r = measure(std::min<size_t>(opt.reps, pairs.size()), [&](size_t i) { bsp::navmesh::flow_field(bsp, navmesh, pairs[i].second, field); });
+            report(name, n, "flow_field", r);
+            r = measure(pairs.size(), [&](size_t i) {
+                vec2_t w;
+                acc = acc + bsp::navmesh::flow_next(bsp, navmesh, field, pairs[i].first, w);
+            });
+            report(name, n, "flow_next", r);
+        }
+    }
+}
+
+std::vector<std::string> split_list(char const* s) {
+    std::vector<std::string> out;
+    std::string cur;
+    for (; *s; s++) {
+        if (',' == *s) {
+            if (!cur.empty()) out.push_back(cur);
+            cur.clear();
+        } else {
+            cur.push_back(*s);
+        }
+    }
+    if (!cur.empty()) out.push_back(cur);
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    options_t opt;
+    for (int i=1; i<argc; i++) {
+        char const* arg = argv[i];
+        char const* val = (i + 1 < argc) ? argv[i+1] : nullptr;
+        if (!val) {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 1;
+        }
+
+        if (0 == strcmp(arg, "--sizes")) {
+            opt.sizes.clear();
+            for (std::string const& s : split_list(val)) opt.sizes.push_back(strtoull(s.c_str(), nullptr, 10));
+        } else if (0 == strcmp(arg, "--maps")) {
+            opt.maps = split_list(val);
+        } else if (0 == strcmp(arg, "--queries")) {
+            opt.queries = strtoull(val, nullptr, 10);
+        } else if (0 == strcmp(arg, "--reps")) {
+            opt.reps = strtoull(val, nullptr, 10);
+        } else if (0 == strcmp(arg, "--seed")) {
+            opt.seed = strtoul(val, nullptr, 10);
+        } else if (0 == strcmp(arg, "--max-csg")) {
+            opt.max_csg = strtoull(val, nullptr, 10);
+        } else if (0 == strcmp(arg, "--max-navmesh")) {
+            opt.max_navmesh = strtoull(val, nullptr, 10);
+        } else if (0 == strcmp(arg, "--max-depth")) {
+            opt.build.max_depth = strtoul(val, nullptr, 10);
+        } else if (0 == strcmp(arg, "--heuristic")) {
+            if (0 == strcmp(val, "mean")) {
+                opt.build.heuristic = bsp::split_heuristic_t::geometric_mean;
+            } else if (0 == strcmp(val, "cost")) {
+                opt.build.heuristic = bsp::split_heuristic_t::sampled_cost;
+            } else {
+                fprintf(stderr, "unknown heuristic %s\n", val);
+                return 1;
+            }
+        } else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 1;
+        }
+        i++;
+    }
+
+    printf("%-8s %9s  %-14s %9s %14s %12s %12s %12s %12s %12s\n",
+           "map", "segments", "op", "calls", "ops/s", "p50 us", "p90 us", "p99 us", "max us", "peak KiB");
+
+    std::mt19937 rng(opt.seed);
+
+    for (std::string const& map : opt.maps) {
+        if ("stl" == map) {
+            bsp::bsp_t bsp;
+            result_t r = measure(opt.reps, [&](size_t) { bsp = bsp::from_stl(test_stl, test_stl_len); });
+            report("stl", 0, "from_stl", r);
+            run_map(opt, "stl", {}, bsp, rng);
+            continue;
+        }
+
+        if ("stlgrid" == map) { // sizes are triangle counts
+            for (size_t size : opt.sizes) {
+                std::vector<uint8_t> stl = gen_stl_grid(size, rng);
+                size_t n_tris = (stl.size() - 84) / 50;
+                bsp::bsp_t bsp;
+                result_t r = measure(opt.reps, [&](size_t) { bsp = bsp::from_stl(stl.data(), stl.size()); });
+                report("stlgrid", n_tris, "from_stl", r);
+                run_map(opt, "stlgrid", {}, bsp, rng);
+            }
+            continue;
+        }
+
+        std::vector<line_t> (*gen)(size_t, std::mt19937 &) = nullptr;
+        if ("rooms" == map) gen = gen_rooms;
+        if ("maze" == map) gen = gen_maze;
+        if ("scatter" == map) gen = gen_scatter;
+        if (!gen) {
+            fprintf(stderr, "unknown map %s\n", map.c_str());
+            return 1;
+        }
+
+        for (size_t size : opt.sizes) {
+            std::vector<line_t> lines = gen(size, rng);
+            run_map(opt, map.c_str(), lines, bsp::bsp_t(), rng);
+        }
+    }
+
+    return 0;
+}
@@ -1,13 +1,144 @@
+#include <array>
+#include <tuple>
+#include <bit>
+#include <cstring>
+#include <memory>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "bsp.hpp"
+#include "thread_pool.hpp"
 
 namespace alh::bsp {
 
 namespace {
 
+// query counters, see query_stats_t. compiled out they are no code at all
+thread_local query_stats_t t_query_stats = {};
+
+#if defined(ALH_BSP_STATS)
+#define BSP_COUNT(field, n) (t_query_stats.field += (n))
+#define BSP_COUNT_MAX(field, n) (t_query_stats.field = std::max<uint32_t>(t_query_stats.field, (n)))
+#else
+#define BSP_COUNT(field, n) ((void)0)
+#define BSP_COUNT_MAX(field, n) ((void)0)
+#endif
+
+// serialized layout, all fields little-endian:
+//   header  : u32 magic, u32 version, u32 node count, u32 reserved (zero)
+//   planes  : node count * bsp_plane_t (f32 nx, ny, d, u32 right, left)
+//   nodes   : node count * flat_node_t (f32 px, py, qx, qy, t1, t2, u32 right, left)
+// node ids and leaf ids are stored as is, so the buffer has no pointers
+constexpr uint32_t FORMAT_MAGIC = 0x50534241; // "ABSP"
+constexpr uint32_t FORMAT_VERSION = 2;
+constexpr size_t HEADER_SIZE = 16;
+
+void put_u32(std::vector<uint8_t> &out, uint32_t v) {
+    for (int i=0; i<4; i++) out.push_back((v >> (8 * i)) & 0xff);
+}
+
+void put_f32(std::vector<uint8_t> &out, float v) {
+    put_u32(out, std::bit_cast<uint32_t>(v));
+}
+
+uint32_t get_u32(uint8_t const* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+float get_f32(uint8_t const* in) {
+    return std::bit_cast<float>(get_u32(in));
+}
+
+// node count of a serialized tree, 0 if the header or any child id is bad. queries follow
+// the children without checks, so they have to stay in the buffer and, as in a built
+// tree, interior children come after their parent (else a query could loop forever)
+size_t check_blob(uint8_t const* data, size_t len) {
+    if (len < HEADER_SIZE) return 0;
+    if (FORMAT_MAGIC != get_u32(data) || FORMAT_VERSION != get_u32(data + 4)) return 0;
+
+    size_t n_nodes = get_u32(data + 8);
+    if (0 == n_nodes || (len - HEADER_SIZE) / (sizeof(bsp_plane_t) + sizeof(flat_node_t)) < n_nodes) return 0;
+
+    uint8_t const* planes = data + HEADER_SIZE;
+    uint8_t const* nodes = planes + n_nodes * sizeof(bsp_plane_t);
+    for (size_t i=0; i<n_nodes; i++) {
+        auto b_child_ok = [&](uint8_t const* in) { id_t child = get_u32(in); return is_leaf(child) || (child > i && child < n_nodes); };
+        uint8_t const* h = planes + i * sizeof(bsp_plane_t);
+        uint8_t const* n = nodes + i * sizeof(flat_node_t);
+        if (!b_child_ok(h + 12) || !b_child_ok(h + 16)) return 0;
+        if (!b_child_ok(n + 24) || !b_child_ok(n + 28)) return 0;
+    }
+    return n_nodes;
+}
+
+// uniform node access for bsp_t and bsp_view_t
+bsp_node_t const& get_node(bsp_t const& bsp, id_t nid) {
+    return bsp[nid];
+}
+
+bsp_node_t get_node(bsp_view_t const& bsp, id_t nid) {
+    flat_node_t const& n = bsp.nodes[nid];
+    line_t l = {{n.px, n.py}, {n.qx, n.qy}, nullptr};
+    return {paramline_t(l, n.t1, n.t2), n.right, n.left};
+}
+
+// node bounds, views don't have them
+bsp_bounds_t const* get_bounds(bsp_t const& bsp) {
+    return (!bsp.empty() && bsp.bounds.size() == bsp.size()) ? bsp.bounds.data() : nullptr;
+}
+
+bsp_bounds_t const* get_bounds(bsp_view_t const&) {
+    return nullptr;
+}
+
+// whether the box around the part p..q of a line overlaps b. cheaper than clipping
+// the line to the box, parts that miss b but overlap its box are walked as before
+bool reaches(bsp_bounds_t const& b, vec2_t p, vec2_t q) {
+    return std::min(p.x, q.x) <= b.max.x && b.min.x <= std::max(p.x, q.x)
+        && std::min(p.y, q.y) <= b.max.y && b.min.y <= std::max(p.y, q.y);
+}
+
+// empty tree whose vectors allocate from memory, nullptr is the global heap
+bsp_t make_tree(std::pmr::memory_resource *memory) {
+    if (!memory) memory = std::pmr::get_default_resource();
+    return {std::pmr::vector<bsp_plane_t>(memory), std::pmr::vector<bsp_node_t>(memory), std::pmr::vector<bsp_bounds_t>(memory)};
+}
+
+bsp_t copy_tree(bsp_t const& src, std::pmr::memory_resource *memory) {
+    bsp_t out = make_tree(memory);
+    out.planes.assign(src.planes.begin(), src.planes.end());
+    out.nodes.assign(src.nodes.begin(), src.nodes.end());
+    out.bounds.assign(src.bounds.begin(), src.bounds.end());
+    return out;
+}
+
+convex_poly_t make_poly(std::pmr::memory_resource *memory) {
+    return {std::pmr::vector<vec2_t>(memory), std::pmr::vector<id_t>(memory)};
+}
+
+// nodes a build of n segments makes, cuts add a few percent on typical maps
+size_t build_size_estimate(size_t n) {
+    return n + n / 4 + 1;
+}
+
 struct build_context_t {
+    build_options_t options;
+    build_stats_t stats;
     uint32_t leaf_id_acc;
-    bsp_t nodes;
-    std::vector<paramline_t> tmp;
+    std::pmr::vector<bsp_node_t> nodes;
+    std::pmr::vector<paramline_t> tmp;
+
+    explicit build_context_t(std::pmr::memory_resource *memory = nullptr)
+        : nodes(memory ? memory : std::pmr::get_default_resource()), tmp(memory ? memory : std::pmr::get_default_resource()) { }
+
+    // parallel build: large right subtrees are built by tasks in a context of their
+    // own, their place in nodes is marked with NULL_ID. spawned is in node order
+    thread_pool_t::task_group_t *group;
+    std::vector<std::unique_ptr<build_context_t>> spawned;
 };
 
 bool split_line(paramline_t const& hyperplane, paramline_t const& subj, paramline_t &out1, paramline_t &out2) {
@@ -22,7 +153,9 @@ bool split_line(paramline_t const& hyperplane, paramline_t const& subj, paramlin
     if ((b_result = line_intersect_gg3(l1, l2, alpha, beta))) {
         vec2_t i_pq = l2.p + (l2.q - l2.p) * beta;
         constexpr float eps2 = 0.1 * 0.1; // minimum allowed deviation in position
-        if (b_result &= (subj.t1 < beta == beta < subj.t2 && dist2(l3.p, i_pq) > eps2 && dist2(l3.q, i_pq) > eps2)) {
+        // and the params apart as paramline_t wants them, which long lines reach first
+        if (b_result &= (subj.t1 < beta == beta < subj.t2 && dist2(l3.p, i_pq) > eps2 && dist2(l3.q, i_pq) > eps2
+                         && fabs(subj.t1 - beta) > 1e-4 && fabs(beta - subj.t2) > 1e-4)) {
             out1 = {subj.line, subj.t1, beta};
             out2 = {subj.line, beta, subj.t2};
         }
@@ -31,7 +164,7 @@ bool split_line(paramline_t const& hyperplane, paramline_t const& subj, paramlin
     return b_result;
 }
 
-id_t h_geometric_mean(std::vector<paramline_t> const& planes, id_t i_begin, id_t i_end) {
+id_t h_geometric_mean(std::pmr::vector<paramline_t> const& planes, id_t i_begin, id_t i_end) {
     // select plane closest to the geometric mean
     assert(planes.size() > 0);
 
@@ -47,7 +180,7 @@ id_t h_geometric_mean(std::vector<paramline_t> const& planes, id_t i_begin, id_t
         mean = mean + (l.q - mean) / (n+1);
     }
 
-    id_t nearest_i = 0;
+    id_t nearest_i = i_begin;
     float nearest_d2 = std::numeric_limits<float>::infinity();
     for (id_t i=i_begin; i != i_end && i != planes.size(); i++) {
         line_t l = planes[i].apply();
@@ -61,18 +194,126 @@ id_t h_geometric_mean(std::vector<paramline_t> const& planes, id_t i_begin, id_t
     return nearest_i;
 }
 
-id_t build_impl(build_context_t &ctx, paramline_t hyperplane, id_t i_begin, id_t i_end) {
+id_t h_sampled_cost(build_context_t const& ctx, id_t i_begin, id_t i_end) {
+    // score evenly spaced candidates against every segment in the range
+    assert(i_begin < i_end);
+    build_options_t const& o = ctx.options;
+    id_t n = i_end - i_begin;
+    id_t n_samples = std::min<id_t>(std::max<uint32_t>(o.n_samples, 1), n);
+
+    id_t best_i = i_begin;
+    float best_score = std::numeric_limits<float>::infinity();
+    for (id_t k=0; k<n_samples; k++) {
+        id_t i_c = i_begin + (id_t)((uint64_t)k * n / n_samples);
+        bsp_plane_t h = make_plane(ctx.tmp[i_c], 0, 0);
+
+        uint32_t n_left = 0, n_right = 0, n_split = 0;
+        for (id_t i=i_begin; i<i_end; i++) {
+            if (i == i_c) continue;
+            line_t l = ctx.tmp[i].apply();
+            bool l_p = h.is_left(l.p);
+            if (l_p != h.is_left(l.q)) n_split++;
+            else if (l_p) n_left++;
+            else n_right++;
+        }
+
+        // split segments end up on both sides
+        float l = n_left + n_split, r = n_right + n_split;
+        float score = o.split_weight * n_split + o.balance_weight * fabsf(l - r)
+                    + o.traversal_weight * (l*l + r*r) / std::max(l + r, 1.f);
+        if (score < best_score) {
+            best_i = i_c;
+            best_score = score;
+        }
+    }
+
+    return best_i;
+}
+
+id_t h_balanced(build_context_t const& ctx, id_t i_begin, id_t i_end) {
+    // candidate that leaves the fewest segments on its larger side, cut segments go
+    // to both. fewer cuts break ties
+    assert(i_begin < i_end);
+    id_t n = i_end - i_begin;
+    id_t n_samples = std::min<id_t>(std::max<uint32_t>(ctx.options.n_samples, 1), n);
+
+    // candidates are offset by k too, outlines come in runs of a few segments and an
+    // even spacing can land on the same side of every one
+    id_t best_i = i_begin;
+    uint64_t best_score = std::numeric_limits<uint64_t>::max();
+    for (id_t k=0; k<n_samples; k++) {
+        id_t i_c = i_begin + (id_t)(((uint64_t)k * n / n_samples + k) % n);
+        bsp_plane_t h = make_plane(ctx.tmp[i_c], 0, 0);
+
+        uint32_t n_left = 0, n_right = 0, n_split = 0;
+        for (id_t i=i_begin; i<i_end; i++) {
+            if (i == i_c) continue;
+            line_t l = ctx.tmp[i].apply();
+            bool l_p = h.is_left(l.p);
+            if (l_p != h.is_left(l.q)) n_split++;
+            else if (l_p) n_left++;
+            else n_right++;
+        }
+
+        uint64_t score = (uint64_t)std::max(n_left, n_right) + n_split;
+        score = (score << 32) | n_split;
+        if (score < best_score) {
+            best_i = i_c;
+            best_score = score;
+        }
+    }
+
+    return best_i;
+}
+
+// depth is that of the node the plane is for, root is 1
+id_t select_plane(build_context_t &ctx, id_t i_begin, id_t i_end, uint32_t depth) {
+    // halving from here on just keeps to max_depth
+    uint32_t max_depth = ctx.options.max_depth;
+    if (max_depth && depth + std::bit_width(i_end - i_begin) > max_depth) {
+        ctx.stats.balanced++;
+        return h_balanced(ctx, i_begin, i_end);
+    }
+
+    switch (ctx.options.heuristic) {
+        case split_heuristic_t::sampled_cost: return h_sampled_cost(ctx, i_begin, i_end);
+        case split_heuristic_t::geometric_mean: break;
+    }
+    return h_geometric_mean(ctx.tmp, i_begin, i_end);
+}
+
+id_t build_impl(build_context_t &ctx, paramline_t hyperplane, id_t i_begin, id_t i_end, uint32_t depth);
+
+// move tmp[i_begin, end) to a new context and build it there as a task. indices and
+// appended splits keep their offsets, so the subtree comes out as in the serial build
+void spawn_subtree(build_context_t &ctx, paramline_t hyperplane, id_t i_begin, id_t i_end, uint32_t depth) {
+    std::unique_ptr<build_context_t> sub = std::make_unique<build_context_t>();
+    sub->options = ctx.options;
+    sub->stats = {};
+    sub->leaf_id_acc = 0;
+    sub->group = ctx.group;
+    sub->tmp.assign(ctx.tmp.begin() + i_begin, ctx.tmp.end());
+    ctx.tmp.resize(i_begin);
+
+    build_context_t *p = sub.get();
+    ctx.spawned.push_back(std::move(sub));
+    ctx.options.pool->spawn(*ctx.group, [=]() { build_impl(*p, hyperplane, 0, i_end - i_begin, depth); });
+}
+
+id_t build_impl(build_context_t &ctx, paramline_t hyperplane, id_t i_begin, id_t i_end, uint32_t depth) {
+    ctx.stats.depth = std::max(ctx.stats.depth, depth);
     
-    line_t lh = hyperplane.apply();
+    bsp_plane_t h = make_plane(hyperplane, 0, 0);
     
     // split line segment if p and q are on opposite sides of hyperplane
     for (id_t i=i_begin; i != i_end && i != ctx.tmp.size(); i++) {
         line_t l = ctx.tmp[i].apply();
-        if (l.p.is_left_of(lh) != l.q.is_left_of(lh)) {
+        if (h.is_left(l.p) != h.is_left(l.q)) {
             paramline_t out1, out2;
             if (split_line(hyperplane, ctx.tmp[i], out1, out2)) {
                 ctx.tmp[i] = out1;
                 ctx.tmp.push_back(out2);
+                ctx.stats.splits++;
             }
         }
     }
@@ -81,7 +322,7 @@ id_t build_impl(build_context_t &ctx, paramline_t hyperplane, id_t i_begin, id_t
     auto right_side = std::partition(ctx.tmp.begin() + i_begin, ctx.tmp.end(), [=](paramline_t const& pl) {
         line_t l = pl.apply();
         vec2_t mid = (l.p + l.q) / 2.f;
-        return mid.is_left_of(lh);
+        return h.is_left(mid);
     });
     id_t i_split = std::distance(ctx.tmp.begin(), right_side);
 
@@ -89,21 +330,26 @@ id_t build_impl(build_context_t &ctx, paramline_t hyperplane, id_t i_begin, id_t
     id_t i_self = ctx.nodes.size();
     ctx.nodes.push_back({hyperplane, 0, 0});
 
-    // pop last line in tmp, (todo: select with heuristic and swap+pop)
+    // select with heuristic and swap+pop
     if (id_t i_last = ctx.tmp.size(); i_split < i_last) {
-        id_t i_h = h_geometric_mean(ctx.tmp, i_split, i_last);
+        id_t i_h = select_plane(ctx, i_split, i_last, depth + 1);
         paramline_t right_split = ctx.tmp[i_h];
         ctx.tmp[i_h] = ctx.tmp.back(); ctx.tmp.pop_back();
-        ctx.nodes[i_self].right = build_impl(ctx, right_split, i_split, i_last);
+        if (ctx.options.pool && i_last - i_split >= ctx.options.task_grain) {
+            ctx.nodes[i_self].right = NULL_ID;
+            spawn_subtree(ctx, right_split, i_split, i_last, depth + 1);
+        } else {
+            ctx.nodes[i_self].right = build_impl(ctx, right_split, i_split, i_last, depth + 1);
+        }
     } else {
         ctx.nodes[i_self].right = ((ctx.leaf_id_acc++) | IS_LEAF) & ~IS_SOLID;
     }
 
     if (i_begin < i_split) {
-        id_t i_h = h_geometric_mean(ctx.tmp, i_begin, i_split);
+        id_t i_h = select_plane(ctx, i_begin, i_split, depth + 1);
         paramline_t left_split = ctx.tmp[i_h];
         ctx.tmp[i_h] = ctx.tmp.back(); ctx.tmp.pop_back();
-        ctx.nodes[i_self].left = build_impl(ctx, left_split, i_begin, i_split);
+        ctx.nodes[i_self].left = build_impl(ctx, left_split, i_begin, i_split, depth + 1);
     } else {
         ctx.nodes[i_self].left = ((ctx.leaf_id_acc++) | IS_LEAF) | IS_SOLID;
     }
@@ -111,238 +357,1531 @@ id_t build_impl(build_context_t &ctx, paramline_t hyperplane, id_t i_begin, id_t
     return i_self;
 }
 
-bool sweep_impl(bsp_t const& bsp, id_t nid, line_t const& line, float t1, float t2, paramline_t last_line, vec2_t &out, line_t &out_line) {
-    if (empty_leaf(nid)) return false;
-    if (solid_leaf(nid)) {
-        out_line = last_line.apply().w_normal();
-        out = line.p + (line.q - line.p) * (t1 - 1e-4);
+// copy the nodes of a parallel build to out in serial order (self, right, left) and
+// number the leaves in the order they are reached, which is how build_impl does it
+id_t emit_subtree(build_context_t &ctx, id_t nid, size_t &i_spawned, std::pmr::vector<bsp_node_t> &out, build_stats_t &stats) {
+    id_t i_self = out.size();
+    out.push_back(ctx.nodes[nid]);
+
+    auto emit_child = [&](id_t child) -> id_t {
+        if (NULL_ID == child) { // built by a task, its root is node 0 there
+            build_context_t &sub = *ctx.spawned[i_spawned++];
+            stats.depth = std::max(stats.depth, sub.stats.depth);
+            stats.splits += sub.stats.splits;
+            stats.balanced += sub.stats.balanced;
+            size_t i_sub = 0;
+            return emit_subtree(sub, 0, i_sub, out, stats);
+        }
+        if (is_leaf(child)) return (stats.leaf_count++ | IS_LEAF) | (child & IS_SOLID);
+        return emit_subtree(ctx, child, i_spawned, out, stats);
+    };
+
+    id_t right = emit_child(out[i_self].right);
+    id_t left = emit_child(out[i_self].left);
+    out[i_self].right = right;
+    out[i_self].left = left;
+    return i_self;
+}
+
+// build from the segments in ctx.tmp, the tree is allocated from options.memory
+bsp_t build_tree(build_context_t &ctx, build_options_t const& options, build_stats_t *stats) {
+    thread_pool_t::task_group_t group;
+    ctx.options = options;
+    ctx.stats = {};
+    ctx.leaf_id_acc = 0;
+    ctx.group = &group;
+    ctx.nodes.reserve(build_size_estimate(ctx.tmp.size()));
+
+    // select root hyperplane
+    id_t i_h = select_plane(ctx, 0, ctx.tmp.size(), 1);
+    paramline_t hyperplane = ctx.tmp[i_h];
+    ctx.tmp[i_h] = ctx.tmp.back(); ctx.tmp.pop_back();
+    build_impl(ctx, hyperplane, 0, ctx.tmp.size(), 1);
+
+    build_stats_t out_stats = ctx.stats;
+    out_stats.leaf_count = ctx.leaf_id_acc;
+
+    bsp_t bsp = make_tree(options.memory);
+    if (options.pool) { // stitch the subtrees together, renumbering nodes and leaves
+        options.pool->wait(group);
+        size_t n_nodes = ctx.nodes.size();
+        for (auto const& sub : ctx.spawned) n_nodes += sub->nodes.size();
+        bsp.nodes.reserve(n_nodes);
+        size_t i_spawned = 0;
+        out_stats.leaf_count = 0;
+        emit_subtree(ctx, 0, i_spawned, bsp.nodes, out_stats);
+    } else {
+        bsp.nodes = std::move(ctx.nodes);
+    }
+
+    if (stats) {
+        *stats = out_stats;
+        stats->node_count = bsp.nodes.size();
+    }
+
+    bsp.planes.resize(bsp.nodes.size());
+    auto make_planes = [&](size_t begin, size_t end) {
+        for (size_t i=begin; i<end; i++) {
+            bsp_node_t const& n = bsp.nodes[i];
+            bsp.planes[i] = make_plane(n.plane, n.right, n.left);
+        }
+    };
+    if (options.pool) {
+        options.pool->parallel_for(bsp.nodes.size(), 16384, make_planes);
+    } else {
+        make_planes(0, bsp.nodes.size());
+    }
+    if (options.node_bounds) compute_bounds(bsp);
+    return bsp;
+}
+
+// explicit stack for the far halves of split segments, spills to the heap
+// only for trees deeper than the inline capacity
+template<typename T, size_t N = 64>
+struct traversal_stack_t {
+    T items[N];
+    size_t n_items = 0;
+    std::vector<T> spill;
+
+    void push(T const& item) {
+        if (n_items < N) items[n_items++] = item;
+        else spill.push_back(item);
+        BSP_COUNT_MAX(max_stack, n_items + spill.size());
+    }
+
+    bool pop(T &item) {
+        if (!spill.empty()) {
+            item = spill.back();
+            spill.pop_back();
+            return true;
+        }
+        if (0 == n_items) return false;
+        item = items[--n_items];
         return true;
     }
+};
+
+struct sweep_item_t {
+    id_t nid;
+    float t1, t2;
+    id_t last_nid;
+};
+
+template<typename tree_t>
+bool sweep_impl(tree_t const& bsp, id_t nid, line_t const& line, float t1, float t2, id_t last_nid, vec2_t &out, line_t &out_line) {
+    traversal_stack_t<sweep_item_t> stack;
+    bsp_bounds_t const* bounds = get_bounds(bsp);
+    BSP_COUNT(queries, 1);
+
+    for (;;) {
+        while (!is_leaf(nid)) {
+            bsp_plane_t const& h = bsp.planes[nid];
+            BSP_COUNT(nodes, 1);
+
+            vec2_t p_t1 = line.p + (line.q - line.p) * t1;
+            vec2_t p_t2 = line.p + (line.q - line.p) * t2;
+
+            if (h.is_left(p_t1) == h.is_left(p_t2)) {
+                nid = h.child(p_t1);
+            } else if (bounds && !reaches(bounds[nid], p_t1, p_t2)) {
+                // no segment below cuts the part, it is all solid or all empty
+                vec2_t mid = (p_t1 + p_t2) / 2.f;
+                while (!is_leaf(nid)) {
+                    nid = bsp.planes[nid].child(mid);
+                    BSP_COUNT(nodes, 1);
+                }
+            } else { // split swept line, visit near half first
+                BSP_COUNT(splits, 1);
+                float t = h.intersect(line.p, line.q);
+                id_t first = h.is_left(p_t1) ? h.left : h.right;
+                id_t second = h.is_left(p_t1) ? h.right : h.left;
+                stack.push({second, t, t2, nid});
+                nid = first;
+                t2 = t;
+            }
+        }
+
+        if (solid_leaf(nid)) {
+            // only the hit plane touches the cold node data
+            if (NULL_ID != last_nid) {
+                out_line = get_node(bsp, last_nid).plane.apply().w_normal();
+            } else { // started in solid, no plane was crossed
+                out_line = {line.p, line.p, nullptr, {0.f, 0.f}};
+            }
+            out = line.p + (line.q - line.p) * (t1 - 1e-4);
+            return true;
+        }
+
+        sweep_item_t next;
+        if (!stack.pop(next)) return false;
+        nid = next.nid;
+        t1 = next.t1;
+        t2 = next.t2;
+        last_nid = next.last_nid;
+    }
+}
 
-    bsp_node_t const& node = bsp[nid];
-    line_t lh = node.plane.apply();
+// walks a sweep_many() group down together while the box around all its lines is on
+// one side of the plane, one test instead of one per line. the float dot is monotone
+// in x and y, so the two box corners furthest along and against the normal decide for
+// every end point in the box exactly as is_left() would. below the first plane that
+// cuts the box each line goes on with its own sweep
+void sweep_group(bsp_t const& bsp, std::span<line_t const> lines, std::span<sweep_hit_t> hits) {
+    vec2_t min = lines[0].p, max = lines[0].p;
+    for (line_t const& l : lines) {
+        min = {std::min({min.x, l.p.x, l.q.x}), std::min({min.y, l.p.y, l.q.y})};
+        max = {std::max({max.x, l.p.x, l.q.x}), std::max({max.y, l.p.y, l.q.y})};
+    }
 
-    vec2_t p_t1 = line.p + (line.q - line.p) * t1;
-    vec2_t p_t2 = line.p + (line.q - line.p) * t2;
+    id_t nid = 0;
+    while (!is_leaf(nid)) {
+        bsp_plane_t const& h = bsp.planes[nid];
+        BSP_COUNT(nodes, 1);
+        vec2_t lo = {(h.nx < 0.f) ? max.x : min.x, (h.ny < 0.f) ? max.y : min.y};
+        vec2_t hi = {(h.nx < 0.f) ? min.x : max.x, (h.ny < 0.f) ? min.y : max.y};
+        if (h.is_left(hi)) nid = h.left;
+        else if (!h.is_left(lo)) nid = h.right;
+        else break;
+    }
 
-    if (p_t1.is_left_of(lh) == p_t2.is_left_of(lh)) {
-        id_t next = p_t1.is_left_of(lh) ? node.left : node.right;
-        return sweep_impl(bsp, next, line, t1, t2, last_line, out, out_line);
-    } else { // split swept line (aka pass new t1 & t2)
-        float t, s;
-        line_intersect_gg3(line, lh, t, s);
+    for (size_t i=0; i<lines.size(); i++)
+        hits[i].hit = sweep_impl(bsp, nid, lines[i], 0.f, 1.f, NULL_ID, hits[i].point, hits[i].plane);
+}
 
-        id_t first = p_t1.is_left_of(lh) ? node.left : node.right;
-        id_t second = p_t1.is_left_of(lh) ? node.right : node.left;
+template<typename tree_t, typename point_t>
+bool is_solid_impl(tree_t const& bsp, id_t nid, point_t const& point) {
+    // walk until leaf
+    BSP_COUNT(queries, 1);
+    while (!is_leaf(nid)) {
+        nid = bsp.planes[nid].child(point);
+        BSP_COUNT(nodes, 1);
+    }
+    return solid_leaf(nid);
+}
 
-        if (sweep_impl(bsp, first, line, t1, t, last_line, out, out_line)) return true;
-        return sweep_impl(bsp, second, line, t, t2, node.plane, out, out_line);
+template<typename tree_t, typename point_t>
+id_t leaf_id_impl(tree_t const& bsp, id_t nid, point_t const& point) {
+    BSP_COUNT(queries, 1);
+    while (!is_leaf(nid)) {
+        nid = bsp.planes[nid].child(point);
+        BSP_COUNT(nodes, 1);
     }
+    return (nid & ~IS_LEAF) & ~IS_SOLID;
 }
 
-// clip line against bsp tree recursively
-bool clip_impl(clip_context_t &ctx, id_t nid, float t1, float t2) {
-    
-    if (solid_leaf(nid)) return ctx.on_solid(ctx, t1, t2, ctx.userdata);
-    if (empty_leaf(nid)) return ctx.on_empty(ctx, t1, t2, ctx.userdata);
+// params along a fixed point sweep run from 0 at p to FIXED_T_ONE at q
+constexpr int64_t FIXED_T_ONE = (int64_t)1 << 32;
+
+struct fixed_sweep_item_t {
+    id_t nid;
+    int64_t t1, t2;
+    id_t last_nid;
+};
+
+// whether the point at param t is left of a plane, sp and sp + ds are the sides of
+// the line ends. exact: sp * 2^32 + ds * t is summed in two 64 bit halves
+bool fixed_left_at(int64_t sp, int64_t ds, int64_t t) {
+    int64_t hi = sp + (ds >> 32) * t;
+    uint64_t lo = (uint64_t)(ds & 0xffffffff) * (uint64_t)t;
+    return hi + (int64_t)(lo >> 32) < 0;
+}
+
+// param where the line crosses a plane, sp and sq are the sides of the ends and
+// differ in sign. both are scaled down to 32 bits first, so the param may be off
+// by about 2^-31 of the line length, but it stays on the line
+int64_t fixed_crossing(int64_t sp, int64_t sq) {
+    uint64_t num = (sp < 0) ? -(uint64_t)sp : (uint64_t)sp;
+    uint64_t den = num + ((sq < 0) ? -(uint64_t)sq : (uint64_t)sq);
+    int shift = std::max(0, (int)std::bit_width(den) - 32);
+    return (int64_t)(((num >> shift) << 32) / (den >> shift));
+}
+
+// point at param t, rounded towards p
+vec2i_t fixed_at(vec2i_t const& p, vec2i_t const& q, int64_t t) {
+    return {p.x + (int32_t)((int64_t)(q.x - p.x) * t / FIXED_T_ONE),
+            p.y + (int32_t)((int64_t)(q.y - p.y) * t / FIXED_T_ONE)};
+}
+
+bool fixed_sweep_impl(fixed_bsp_t const& bsp, vec2i_t const& p, vec2i_t const& q, vec2i_t &hit, id_t &hit_nid) {
+    traversal_stack_t<fixed_sweep_item_t> stack;
+    id_t nid = 0, last_nid = NULL_ID;
+    int64_t t1 = 0, t2 = FIXED_T_ONE;
+    BSP_COUNT(queries, 1);
+
+    for (;;) {
+        while (!is_leaf(nid)) {
+            fixed_plane_t const& h = bsp.planes[nid];
+            BSP_COUNT(nodes, 1);
+            int64_t sp = h.side(p), sq = h.side(q);
+            bool b_left1 = fixed_left_at(sp, sq - sp, t1);
+            bool b_left2 = fixed_left_at(sp, sq - sp, t2);
+
+            if (b_left1 == b_left2) {
+                nid = b_left1 ? h.left : h.right;
+                continue;
+            }
+
+            // an end on a plane that was cut at before rounds to the near side of it,
+            // then the cut falls on that end and the part is all on one side
+            int64_t t = std::clamp(fixed_crossing(sp, sq), t1, t2);
+            if (t == t1) {
+                last_nid = nid;
+                nid = b_left2 ? h.left : h.right;
+            } else if (t == t2) {
+                nid = b_left1 ? h.left : h.right;
+            } else { // split swept line, visit near half first
+                BSP_COUNT(splits, 1);
+                stack.push({b_left1 ? h.right : h.left, t, t2, nid});
+                nid = b_left1 ? h.left : h.right;
+                t2 = t;
+            }
+        }
+
+        if (solid_leaf(nid)) {
+            hit = fixed_at(p, q, t1);
+            hit_nid = last_nid;
+            return true;
+        }
+
+        fixed_sweep_item_t next;
+        if (!stack.pop(next)) return false;
+        nid = next.nid;
+        t1 = next.t1;
+        t2 = next.t2;
+        last_nid = next.last_nid;
+    }
+}
+
+// packet point classification, lane masks have one bit per point.
+// the plane test mirrors bsp_plane_t::dot so every width gives the same answers
+#if defined(__AVX2__)
+constexpr size_t PACKET_WIDTH = 8;
+
+uint32_t left_mask(bsp_plane_t const& h, float const* x, float const* y) {
+    __m256 vx = _mm256_load_ps(x);
+    __m256 vy = _mm256_load_ps(y);
+    __m256 nx = _mm256_set1_ps(h.nx);
+    __m256 ny = _mm256_set1_ps(h.ny);
+#if defined(__FMA__)
+    __m256 dot = _mm256_fmadd_ps(nx, vx, _mm256_mul_ps(ny, vy));
+#else
+    __m256 dot = _mm256_add_ps(_mm256_mul_ps(nx, vx), _mm256_mul_ps(ny, vy));
+#endif
+    return _mm256_movemask_ps(_mm256_cmp_ps(dot, _mm256_set1_ps(h.d), _CMP_LT_OQ));
+}
+#elif defined(__SSE2__)
+constexpr size_t PACKET_WIDTH = 4;
+
+uint32_t left_mask(bsp_plane_t const& h, float const* x, float const* y) {
+    __m128 vx = _mm_load_ps(x);
+    __m128 vy = _mm_load_ps(y);
+    __m128 nx = _mm_set1_ps(h.nx);
+    __m128 ny = _mm_set1_ps(h.ny);
+#if defined(__FMA__)
+    __m128 dot = _mm_fmadd_ps(nx, vx, _mm_mul_ps(ny, vy));
+#else
+    __m128 dot = _mm_add_ps(_mm_mul_ps(nx, vx), _mm_mul_ps(ny, vy));
+#endif
+    return _mm_movemask_ps(_mm_cmplt_ps(dot, _mm_set1_ps(h.d)));
+}
+#elif defined(__ARM_NEON)
+constexpr size_t PACKET_WIDTH = 4;
+
+uint32_t left_mask(bsp_plane_t const& h, float const* x, float const* y) {
+    float32x4_t vx = vld1q_f32(x);
+    float32x4_t vy = vld1q_f32(y);
+#if defined(__ARM_FEATURE_FMA)
+    float32x4_t dot = vfmaq_f32(vmulq_n_f32(vy, h.ny), vx, vdupq_n_f32(h.nx));
+#else
+    float32x4_t dot = vaddq_f32(vmulq_n_f32(vx, h.nx), vmulq_n_f32(vy, h.ny));
+#endif
+    static const uint32_t bits[4] = {1, 2, 4, 8};
+    uint32x4_t m = vandq_u32(vcltq_f32(dot, vdupq_n_f32(h.d)), vld1q_u32(bits));
+#if defined(__aarch64__)
+    return vaddvq_u32(m);
+#else
+    uint32x2_t s = vadd_u32(vget_low_u32(m), vget_high_u32(m));
+    return vget_lane_u32(vpadd_u32(s, s), 0);
+#endif
+}
+#else
+constexpr size_t PACKET_WIDTH = 1; // scalar fallback, packets of one never split
+
+uint32_t left_mask(bsp_plane_t const& h, float const* x, float const* y) {
+    return h.is_left({x[0], y[0]});
+}
+#endif
+
+struct packet_item_t {
+    id_t nid;
+    uint32_t mask;
+};
+
+template<typename tree_t>
+void classify_impl(tree_t const& bsp, std::span<vec2_t const> points, std::span<uint8_t> solid, std::span<id_t> leaf_ids) {
+    assert(solid.empty() || solid.size() == points.size());
+    assert(leaf_ids.empty() || leaf_ids.size() == points.size());
+
+    auto write = [&](size_t i, id_t nid) {
+        if (!solid.empty()) solid[i] = solid_leaf(nid);
+        if (!leaf_ids.empty()) leaf_ids[i] = (nid & ~IS_LEAF) & ~IS_SOLID;
+    };
+
+    alignas(32) float x[PACKET_WIDTH];
+    alignas(32) float y[PACKET_WIDTH];
+    traversal_stack_t<packet_item_t> stack;
+    BSP_COUNT(queries, points.size());
+
+    for (size_t i0=0; i0<points.size(); i0+=PACKET_WIDTH) {
+        size_t n = std::min(PACKET_WIDTH, points.size() - i0);
+        for (size_t k=0; k<PACKET_WIDTH; k++) { // pad the tail with the last point
+            vec2_t const& p = points[i0 + std::min(k, n - 1)];
+            x[k] = p.x;
+            y[k] = p.y;
+        }
+
+        // walk the packet down together, split it where the lanes disagree
+        id_t nid = 0;
+        uint32_t mask = (1u << n) - 1;
+        for (;;) {
+            while (!is_leaf(nid)) {
+                bsp_plane_t const& h = bsp.planes[nid];
+                BSP_COUNT(nodes, 1);
+                uint32_t left = left_mask(h, x, y) & mask;
+                uint32_t right = mask & ~left;
+                if (0 == left) {
+                    nid = h.right;
+                } else if (0 == right) {
+                    nid = h.left;
+                } else {
+                    stack.push({h.right, right});
+                    nid = h.left;
+                    mask = left;
+                }
+            }
+
+            for (uint32_t m=mask; m; m &= m - 1) write(i0 + std::countr_zero(m), nid);
+
+            packet_item_t next;
+            if (!stack.pop(next)) break;
+            nid = next.nid;
+            mask = next.mask;
+        }
+    }
+}
 
-    bsp_node_t const& node = (*ctx.bsp)[nid];
-    line_t lh = node.plane.apply();
+struct clip_item_t {
+    id_t nid;
+    float t1, t2;
+};
 
+// clip line against bsp tree, leaves are reported in order along the line
+bool clip_impl(clip_context_t &ctx, id_t nid, float t1, float t2) {
+    traversal_stack_t<clip_item_t> stack;
     line_t l = (*ctx.paramline).line;
-    vec2_t p_t1 = l.p + (l.q - l.p) * t1;
-    vec2_t p_t2 = l.p + (l.q - l.p) * t2;
+    bsp_bounds_t const* bounds = get_bounds(*ctx.bsp);
+    BSP_COUNT(queries, 1);
 
-    if (p_t1.is_left_of(lh) == p_t2.is_left_of(lh)) {
-        id_t next = p_t1.is_left_of(lh) ? node.left : node.right;
-        return clip_impl(ctx, next, t1, t2);
-    } else { // split swept line (aka pass new t1 & t2)
-        float t, s;
-        line_intersect_gg3(l, lh, t, s);
+    for (;;) {
+        while (!is_leaf(nid)) {
+            bsp_plane_t const& h = ctx.bsp->planes[nid];
+            BSP_COUNT(nodes, 1);
 
-        vec2_t p_t = l.p + (l.q - l.p) * t;
-        constexpr float eps2 = 0.1 * 0.1; // minimum allowed deviation in position
+            vec2_t p_t1 = l.p + (l.q - l.p) * t1;
+            vec2_t p_t2 = l.p + (l.q - l.p) * t2;
 
-        if (t1 < t == t < t2 && dist2(p_t, p_t1) > eps2 && dist2(p_t, p_t2) > eps2) {
-            assert(t != t1 && t != t2);
-            id_t first = p_t1.is_left_of(lh) ? node.left : node.right;
-            id_t second = p_t1.is_left_of(lh) ? node.right : node.left;
+            if (h.is_left(p_t1) == h.is_left(p_t2)) {
+                nid = h.child(p_t1);
+                continue;
+            }
 
-            if (clip_impl(ctx, first, t1, t)) return true;
-            return clip_impl(ctx, second, t, t2);
-        } else {
-            // use midpoint
-            id_t next = ((p_t1 + p_t2) / 2.f).is_left_of(lh) ? node.left : node.right;
-            return clip_impl(ctx, next, t1, t2);
+            if (bounds && !reaches(bounds[nid], p_t1, p_t2)) {
+                // one run of leaves of the same kind, reported as one
+                vec2_t mid = (p_t1 + p_t2) / 2.f;
+                while (!is_leaf(nid)) {
+                    nid = ctx.bsp->planes[nid].child(mid);
+                    BSP_COUNT(nodes, 1);
+                }
+                continue;
+            }
+
+            // split swept line (aka pass new t1 & t2)
+            float t = h.intersect(l.p, l.q);
+
+            vec2_t p_t = l.p + (l.q - l.p) * t;
+            constexpr float eps2 = 0.1 * 0.1; // minimum allowed deviation in position
+
+            if (t1 < t == t < t2 && dist2(p_t, p_t1) > eps2 && dist2(p_t, p_t2) > eps2) {
+                assert(t != t1 && t != t2);
+                BSP_COUNT(splits, 1);
+                id_t first = h.is_left(p_t1) ? h.left : h.right;
+                id_t second = h.is_left(p_t1) ? h.right : h.left;
+                stack.push({second, t, t2});
+                nid = first;
+                t2 = t;
+            } else {
+                // use midpoint
+                nid = h.child((p_t1 + p_t2) / 2.f);
+            }
         }
+
+        bool b_stop = solid_leaf(nid) ? ctx.on_solid(ctx, t1, t2, ctx.userdata)
+                                      : ctx.on_empty(ctx, t1, t2, ctx.userdata);
+        if (b_stop) return true;
+
+        clip_item_t next;
+        if (!stack.pop(next)) return false;
+        nid = next.nid;
+        t1 = next.t1;
+        t2 = next.t2;
     }
 }
 
 bool cb_do_nothing(clip_context_t &, float, float, void *) { return false; }
 
-bool cb_push_segment(clip_context_t &ctx, float t1, float t2, void *userdata) {
-    std::vector<paramline_t> &out = *(std::vector<paramline_t> *)userdata;
-    out.push_back(paramline_t(ctx.paramline->line, t1, t2));
-    return false;
+// boolean ops by merging the trees, see union_op(). a is walked with the convex part of
+// each region inside the bounds, b is copied into the leaves of a with the nodes that
+// don't cut the leaf cell left out. op(x, y) is bit (x * 2 + y) of table
+struct merge_context_t {
+    bsp_t const* a;
+    bsp_t const* b;
+    uint8_t table;
+
+    vec2_t b_min, b_max; // extent of the segments of b, outside of it b is b_outside
+    bool b_outside;
+    std::array<line_t, 4> bounds; // box around the extent of b, counter-clockwise
+
+    std::pmr::memory_resource *memory; // result and cell polygons, never nullptr
+    std::pmr::vector<bsp_node_t> nodes;
+    std::pmr::vector<bsp_plane_t> planes;
+    std::vector<id_t> chain; // scratch of merge_b
+
+    explicit merge_context_t(std::pmr::memory_resource *memory) : memory(memory), nodes(memory), planes(memory) { }
+};
+
+// edges of the bounds box are tagged with these, node ids never get that high
+constexpr id_t BOUNDS_TAG = NULL_ID - 4;
+
+// bounding box of the node segments, returns whether the tree is solid outside of it
+bool tree_extent(bsp_t const& bsp, vec2_t &min, vec2_t &max) {
+    static constexpr float inf = std::numeric_limits<float>::infinity();
+    min = {inf, inf};
+    max = {-inf, -inf};
+    for (bsp_node_t const& n : bsp) {
+        line_t l = n.plane.apply();
+        min = {std::min({min.x, l.p.x, l.q.x}), std::min({min.y, l.p.y, l.q.y})};
+        max = {std::max({max.x, l.p.x, l.q.x}), std::max({max.y, l.p.y, l.q.y})};
+    }
+    return is_solid(bsp, 0, max + vec2_t{1.f, 1.f});
 }
 
-bool cb_push_flipped_segment(clip_context_t &ctx, float t1, float t2, void *userdata) {
-    std::vector<paramline_t> &out = *(std::vector<paramline_t> *)userdata;
-    out.push_back(paramline_t(ctx.paramline->line, t2, t1));
+bool merge_state(merge_context_t const& ctx, bool x, bool y) {
+    return (ctx.table >> (x * 2 + y)) & 1;
+}
+
+// solidity of the leaves of a subtree that is copied, by the state in the source
+struct leaf_map_t {
+    bool on_empty, on_solid;
+    bool operator()(bool b_solid) const { return b_solid ? on_solid : on_empty; }
+};
+
+id_t merge_leaf(bool b_solid) {
+    return IS_LEAF | (b_solid ? IS_SOLID : 0); // ids are set once the tree is done
+}
+
+id_t merge_node(merge_context_t &ctx, bsp_t const& src, id_t nid) {
+    ctx.nodes.push_back(src.nodes[nid]);
+    ctx.planes.push_back(src.planes[nid]);
+    return ctx.nodes.size() - 1;
+}
+
+// set the children of node i, a node with two leaves of the same kind is dropped for one
+id_t merge_finish(merge_context_t &ctx, id_t i, id_t right, id_t left) {
+    if (is_leaf(right) && right == left) {
+        assert(i + 1 == ctx.nodes.size()); // children are made after the node
+        ctx.nodes.pop_back();
+        ctx.planes.pop_back();
+        return right;
+    }
+    ctx.nodes[i].right = ctx.planes[i].right = right;
+    ctx.nodes[i].left = ctx.planes[i].left = left;
+    return i;
+}
+
+id_t merge_copy(merge_context_t &ctx, bsp_t const& src, id_t nid, leaf_map_t map) {
+    if (map.on_empty == map.on_solid) return merge_leaf(map.on_empty);
+    if (is_leaf(nid)) return merge_leaf(map(solid_leaf(nid)));
+
+    id_t i = merge_node(ctx, src, nid);
+    id_t right = merge_copy(ctx, src, src.nodes[nid].right, map);
+    id_t left = merge_copy(ctx, src, src.nodes[nid].left, map);
+    return merge_finish(ctx, i, right, left);
+}
+
+// b below nid for the cell poly, nodes whose plane misses poly are skipped. a leaf
+// cell that reaches past the bounds gets the bounds edges, b is b_outside beyond them
+id_t merge_b(merge_context_t &ctx, id_t nid, convex_poly_t const& poly, leaf_map_t map) {
+    bsp_t const& b = *ctx.b;
+    if (is_leaf(nid)) {
+        bool b_solid = map(solid_leaf(nid));
+        bool b_beyond = map(ctx.b_outside);
+        if (b_solid == b_beyond) return merge_leaf(b_solid);
+
+        // outside of each bounds edge is beyond, inside goes on to the next one
+        std::vector<id_t> &chain = ctx.chain;
+        chain.clear();
+        for (id_t tag : poly.tags) {
+            if (tag < BOUNDS_TAG || NULL_ID == tag) continue;
+            paramline_t pl(ctx.bounds[tag - BOUNDS_TAG]);
+            chain.push_back(ctx.nodes.size());
+            ctx.nodes.push_back({pl, merge_leaf(b_beyond), NULL_ID});
+            ctx.planes.push_back(make_plane(pl, merge_leaf(b_beyond), NULL_ID));
+        }
+        id_t child = merge_leaf(b_solid);
+        for (size_t k=chain.size(); k-->0;) child = merge_finish(ctx, chain[k], merge_leaf(b_beyond), child);
+        return child;
+    }
+
+    // most planes miss the cell, that only takes the side test
+    bsp_plane_t const& h = b.planes[nid];
+    bool b_left = h.is_left(poly.verts[0]);
+    if (std::all_of(poly.verts.begin() + 1, poly.verts.end(), [&](vec2_t const& v) { return h.is_left(v) == b_left; }))
+        return merge_b(ctx, h.child(poly.verts[0]), poly, map);
+
+    convex_poly_t right = make_poly(ctx.memory), left = make_poly(ctx.memory);
+    split_poly(poly, h, nid, right, left);
+    if (right.verts.empty()) return merge_b(ctx, h.left, left, map);
+    if (left.verts.empty()) return merge_b(ctx, h.right, right, map);
+
+    id_t i = merge_node(ctx, b, nid);
+    id_t r = merge_b(ctx, b.planes[nid].right, right, map);
+    id_t l = merge_b(ctx, b.planes[nid].left, left, map);
+    return merge_finish(ctx, i, r, l);
+}
+
+// a below nid, poly is its region inside the bounds
+id_t merge_a(merge_context_t &ctx, id_t nid, convex_poly_t const& poly) {
+    bsp_t const& a = *ctx.a;
+
+    // away from the segments of b, b is the same everywhere and a is only relabeled
+    static constexpr float inf = std::numeric_limits<float>::infinity();
+    vec2_t min = {inf, inf}, max = {-inf, -inf};
+    for (vec2_t const& v : poly.verts) {
+        min = {std::min(min.x, v.x), std::min(min.y, v.y)};
+        max = {std::max(max.x, v.x), std::max(max.y, v.y)};
+    }
+    if (poly.verts.empty() || max.x < ctx.b_min.x || max.y < ctx.b_min.y || min.x > ctx.b_max.x || min.y > ctx.b_max.y) {
+        leaf_map_t map = {merge_state(ctx, false, ctx.b_outside), merge_state(ctx, true, ctx.b_outside)};
+        return merge_copy(ctx, a, nid, map);
+    }
+
+    if (is_leaf(nid)) {
+        bool b_solid = solid_leaf(nid);
+        leaf_map_t map = {merge_state(ctx, b_solid, false), merge_state(ctx, b_solid, true)};
+        if (map.on_empty == map.on_solid) return merge_leaf(map.on_empty);
+        return merge_b(ctx, 0, poly, map);
+    }
+
+    // a plane that misses the region leaves the other side empty
+    bsp_plane_t const& h = a.planes[nid];
+    convex_poly_t right = make_poly(ctx.memory), left = make_poly(ctx.memory);
+    convex_poly_t const* p_right = &right, *p_left = &left;
+    bool b_left = h.is_left(poly.verts[0]);
+    if (std::all_of(poly.verts.begin() + 1, poly.verts.end(), [&](vec2_t const& v) { return h.is_left(v) == b_left; }))
+        (b_left ? p_left : p_right) = &poly;
+    else
+        split_poly(poly, h, nid, right, left);
+
+    id_t i = merge_node(ctx, a, nid);
+    id_t r = merge_a(ctx, h.right, *p_right);
+    id_t l = merge_a(ctx, h.left, *p_left);
+    return merge_finish(ctx, i, r, l);
+}
+
+// union of trees that are empty outside of their extents and on either side of the line
+// p -> q, the trees go below a node on the line as they are
+bsp_t join(bsp_t const& right, bsp_t const& left, vec2_t p, vec2_t q, std::pmr::memory_resource *memory) {
+    bsp_t out = make_tree(memory);
+    out.nodes.reserve(1 + right.size() + left.size());
+    out.planes.reserve(1 + right.size() + left.size());
+    paramline_t pl({p, q});
+    id_t n_right_leaves = right.size() + 1;
+    out.nodes.push_back({pl, 1, (id_t)(1 + right.size())});
+    out.planes.push_back(make_plane(pl, out.nodes[0].right, out.nodes[0].left));
+
+    for (auto [src, offset, leaf_offset] : {std::tuple{&right, (id_t)1, (id_t)0},
+                                            std::tuple{&left, (id_t)(1 + right.size()), n_right_leaves}}) {
+        auto shift = [&](id_t child) { return is_leaf(child) ? child + leaf_offset : child + offset; };
+        for (id_t i=0; i<src->size(); i++) {
+            bsp_node_t n = src->nodes[i];
+            bsp_plane_t h = src->planes[i];
+            n.right = h.right = shift(n.right);
+            n.left = h.left = shift(n.left);
+            out.nodes.push_back(n);
+            out.planes.push_back(h);
+        }
+    }
+    return out;
+}
+
+bsp_t merge(bsp_t const& a, bsp_t const& b, uint8_t table, std::pmr::memory_resource *memory) {
+    assert(!a.empty() && !b.empty());
+    if (!memory) memory = std::pmr::get_default_resource();
+
+    merge_context_t ctx(memory);
+    ctx.a = &a;
+    ctx.b = &b;
+    ctx.table = table;
+
+    ctx.b_outside = tree_extent(b, ctx.b_min, ctx.b_max);
+
+    // bounds with some margin, so cells that only reach past b's extent stay large
+    convex_poly_t bounds = bounds_poly(ctx.b_min, ctx.b_max, memory);
+    for (id_t k=0; k<4; k++) {
+        ctx.bounds[k] = {bounds.verts[k], bounds.verts[(k + 1) % 4]};
+        bounds.tags[k] = BOUNDS_TAG + k;
+    }
+
+    // b is cut into the cells it crosses, which adds some to the sum
+    size_t n_estimate = build_size_estimate(a.size() + b.size());
+    ctx.nodes.reserve(n_estimate);
+    ctx.planes.reserve(n_estimate);
+    id_t root = merge_a(ctx, 0, bounds);
+
+    bsp_t out = make_tree(memory);
+    if (is_leaf(root)) {
+        if (empty_leaf(root)) return out; // nothing solid left
+        ctx.nodes.assign({{a.nodes[0].plane, root, root}}); // all solid, one plane holds the leaves
+        ctx.planes.assign({make_plane(a.nodes[0].plane, root, root)});
+    }
+
+    // number the leaves in the order build() does, right subtree first
+    id_t leaf_id_acc = 0;
+    std::vector<std::pair<id_t, bool>> stack = {{0, true}, {0, false}};
+    while (!stack.empty()) {
+        auto [i, b_left] = stack.back();
+        stack.pop_back();
+        id_t &child = b_left ? ctx.nodes[i].left : ctx.nodes[i].right;
+        if (is_leaf(child)) {
+            child = (leaf_id_acc++) | (child & (IS_LEAF | IS_SOLID));
+            (b_left ? ctx.planes[i].left : ctx.planes[i].right) = child;
+        } else {
+            stack.push_back({child, true});
+            stack.push_back({child, false});
+        }
+    }
+
+    out.nodes = std::move(ctx.nodes);
+    out.planes = std::move(ctx.planes);
+    return out;
+}
+
+bool cb_push_run(clip_context_t &, float t1, float t2, void *userdata) {
+    std::vector<std::pair<float, float>> &out = *(std::vector<std::pair<float, float>> *)userdata;
+    out.push_back({t1, t2});
     return false;
 }
 
+// part of a node line between solid and empty, t1 -> t2 with solid on the left
+struct boundary_piece_t {
+    line_t line;
+    float t1, t2;
+
+    bool flipped() const { return t1 > t2; }
+    float lo() const { return std::min(t1, t2); }
+    float hi() const { return std::max(t1, t2); }
+};
+
+// boundary between solid and empty, see rebalance(). the empty runs along the node
+// edges of each solid cell are boundary. pieces on the same line are merged
+std::vector<paramline_t> boundary_segments(bsp_t const& bsp) {
+    vec2_t min, max;
+    tree_extent(bsp, min, max);
+    convex_poly_t bounds = bounds_poly(min, max);
+
+    constexpr float min_len = 1e-3f; // shorter pieces come from rounding, slivers go down to this
+    std::vector<boundary_piece_t> pieces;
+    std::vector<std::pair<float, float>> runs;
+    std::vector<std::pair<id_t, convex_poly_t>> stack;
+    stack.push_back({0, std::move(bounds)});
+    convex_poly_t right, left;
+
+    while (!stack.empty()) {
+        auto [nid, poly] = std::move(stack.back());
+        stack.pop_back();
+
+        if (empty_leaf(nid)) continue;
+        if (!is_leaf(nid)) {
+            split_poly(poly, bsp.planes[nid], nid, right, left);
+            if (!right.verts.empty()) stack.push_back({bsp.planes[nid].right, right});
+            if (!left.verts.empty()) stack.push_back({bsp.planes[nid].left, left});
+            continue;
+        }
+
+        // across an edge is the other child of the node it lies on, the edge is clipped
+        // against that subtree. the cell is on the right of its edges
+        vec2_t center = {0.f, 0.f};
+        for (vec2_t const& v : poly.verts) center = center + v;
+        center = center / poly.verts.size();
+        for (size_t k=0, n=poly.verts.size(); k<n; k++) {
+            if (NULL_ID == poly.tags[k]) continue;
+            vec2_t a = poly.verts[k], b = poly.verts[(k + 1) % n];
+            if (dist2(a, b) < min_len * min_len) continue;
+
+            bsp_plane_t const& h = bsp.planes[poly.tags[k]];
+            paramline_t pl({a, b});
+            clip_context_t ctx = {&bsp, &pl, cb_push_run, cb_do_nothing, &runs};
+            runs.clear();
+            clip(ctx, h.is_left(center) ? h.right : h.left);
+
+            // runs go a -> b, the boundary b -> a keeps the solid cell on its left
+            line_t const& l = bsp[poly.tags[k]].plane.line;
+            vec2_t pq = l.q - l.p;
+            float len2 = pq.x * pq.x + pq.y * pq.y;
+            float t_a = ((a.x - l.p.x) * pq.x + (a.y - l.p.y) * pq.y) / len2;
+            float t_b = ((b.x - l.p.x) * pq.x + (b.y - l.p.y) * pq.y) / len2;
+            for (auto [s1, s2] : runs)
+                pieces.push_back({l, t_a + (t_b - t_a) * s2, t_a + (t_b - t_a) * s1});
+        }
+    }
+
+    // pieces on the same line and facing the same way are joined where they touch,
+    // copies of a node from the boolean ops have the same line
+    auto key = [](boundary_piece_t const& pc) {
+        return std::tuple{pc.line.p.x, pc.line.p.y, pc.line.q.x, pc.line.q.y, pc.flipped(), pc.lo()};
+    };
+    std::sort(pieces.begin(), pieces.end(), [&](auto const& x, auto const& y) { return key(x) < key(y); });
+
+    // pieces keep the node line, so pieces of one line get the same plane
+    std::vector<paramline_t> out;
+    auto emit = [&](boundary_piece_t const& pc) {
+        line_t const& l = pc.line;
+        if (dist2(l.p, l.q) * (pc.hi() - pc.lo()) * (pc.hi() - pc.lo()) < min_len * min_len || pc.hi() - pc.lo() < 2e-4f) return;
+        out.push_back(paramline_t(l, pc.t1, pc.t2));
+    };
+
+    constexpr float join_eps = 1e-4f;
+    for (size_t i=0; i<pieces.size();) {
+        boundary_piece_t acc = pieces[i++];
+        float hi = acc.hi();
+        while (i < pieces.size() && pieces[i].line.p == acc.line.p && pieces[i].line.q == acc.line.q
+               && pieces[i].flipped() == acc.flipped() && pieces[i].lo() <= hi + join_eps) {
+            hi = std::max(hi, pieces[i++].hi());
+        }
+        float lo = acc.lo();
+        acc.t1 = acc.flipped() ? hi : lo;
+        acc.t2 = acc.flipped() ? lo : hi;
+        emit(acc);
+    }
+    return out;
+}
+
+// in place edit with a convex polygon, see insert_obstacle()
+struct edit_context_t {
+    bsp_t *bsp;
+    bool b_insert; // the polygon becomes solid, else empty
+    std::vector<line_t> lines; // of the polygon, inside on their left (solid) side
+
+    std::vector<id_t> free_nodes; // removed by collapsing
+    std::vector<id_t> free_leaves;
+    id_t leaf_id_acc; // next new leaf id past the old ones
+    std::vector<id_t> collapse; // nodes that got a leaf child
+    std::vector<id_t> changed;
+};
+
+void set_child(bsp_t &bsp, id_t parent, bool b_left, id_t child) {
+    if (b_left) bsp.nodes[parent].left = bsp.planes[parent].left = child;
+    else bsp.nodes[parent].right = bsp.planes[parent].right = child;
+}
+
+// the polygon edge that a piece edge from a to b lies on
+size_t polygon_edge(edit_context_t const& ctx, vec2_t a, vec2_t b) {
+    size_t i_edge = 0;
+    float best = std::numeric_limits<float>::infinity();
+    for (size_t j=0; j<ctx.lines.size(); j++) {
+        line_t const& l = ctx.lines[j];
+        float off = fabsf(cross(l.q - l.p, a - l.p)) + fabsf(cross(l.q - l.p, b - l.p));
+        if (off < best) {
+            i_edge = j;
+            best = off;
+        }
+    }
+    return i_edge;
+}
+
+// split the cell of leaf (child b_left of parent) by the polygon edges that cross it,
+// piece is the part of the polygon in the cell. the planes are the whole edges, so
+// points are classified exactly as before outside of the polygon
+void replace_leaf(edit_context_t &ctx, id_t leaf, id_t parent, bool b_left, convex_poly_t const& piece) {
+    bsp_t &bsp = *ctx.bsp;
+    id_t id = leaf & ~(IS_LEAF | IS_SOLID);
+    id_t outside = leaf & (IS_LEAF | IS_SOLID);
+    id_t inside = IS_LEAF | (ctx.b_insert ? IS_SOLID : 0);
+    ctx.changed.push_back(id);
+
+    id_t child = parent;
+    bool b_child_left = b_left;
+    size_t n = piece.verts.size();
+    for (size_t k=0; k<n; k++) {
+        if (NULL_ID != piece.tags[k]) continue; // along a plane of the tree, not an edge
+        vec2_t a = piece.verts[k], b = piece.verts[(k + 1) % n];
+
+        line_t const& l = ctx.lines[polygon_edge(ctx, a, b)];
+        vec2_t e = l.q - l.p;
+        float e2 = e.x * e.x + e.y * e.y;
+        float t1 = ((a.x - l.p.x) * e.x + (a.y - l.p.y) * e.y) / e2;
+        float t2 = ((b.x - l.p.x) * e.x + (b.y - l.p.y) * e.y) / e2;
+        if (t2 - t1 < 2e-4f) { // keep the plane, the segment only has to be valid
+            float t = (t1 + t2) / 2.f;
+            t1 = t - 1e-4f;
+            t2 = t + 1e-4f;
+        }
+
+        // outside of the edge stays as it was, inside goes on to the next edge
+        id_t nid = bsp.nodes.size();
+        id_t right = (ctx.leaf_id_acc++) | outside;
+        ctx.changed.push_back(right & ~(IS_LEAF | IS_SOLID));
+        bsp.nodes.push_back({paramline_t(l, t1, t2), right, NULL_ID});
+        bsp.planes.push_back(make_plane(bsp.nodes.back().plane, right, NULL_ID));
+        set_child(bsp, child, b_child_left, nid);
+        child = nid;
+        b_child_left = true;
+    }
+
+    // the last inside keeps the old id
+    set_child(bsp, child, b_child_left, id | inside);
+    ctx.collapse.push_back(child);
+}
+
+void edit_obstacle(bsp_t &bsp, std::span<vec2_t const> poly, bool b_insert, std::vector<id_t> &changed_leaves) {
+    assert(!bsp.empty());
+    assert(poly.size() >= 3);
+
+    edit_context_t ctx;
+    ctx.bsp = &bsp;
+    ctx.b_insert = b_insert;
+    ctx.leaf_id_acc = bsp.size() + 1; // a tree of n nodes has n + 1 leaves
+
+    // wind the polygon so that its inside is on the solid side of the edges
+    vec2_t center = {0.f, 0.f};
+    for (vec2_t const& v : poly) center = center + v;
+    center = center / poly.size();
+    convex_poly_t piece;
+    piece.verts.assign(poly.begin(), poly.end());
+    if (!make_plane(paramline_t({poly[0], poly[1]}), 0, 0).is_left(center))
+        std::reverse(piece.verts.begin(), piece.verts.end());
+    piece.tags.assign(poly.size(), NULL_ID);
+    for (size_t k=0; k<poly.size(); k++)
+        ctx.lines.push_back({piece.verts[k], piece.verts[(k + 1) % poly.size()]});
+
+    // go down with the parts of the polygon, the leaves they reach are replaced.
+    // the rest of the tree keeps its nodes and leaf ids
+    struct item_t {
+        id_t nid, parent;
+        bool b_left;
+        convex_poly_t piece;
+    };
+    std::vector<item_t> stack;
+    stack.push_back({0, NULL_ID, false, std::move(piece)});
+    convex_poly_t right, left;
+    while (!stack.empty()) {
+        item_t item = std::move(stack.back());
+        stack.pop_back();
+
+        id_t nid = item.nid;
+        if (is_leaf(nid)) {
+            if (solid_leaf(nid) != b_insert) replace_leaf(ctx, nid, item.parent, item.b_left, item.piece);
+            continue;
+        }
+
+        // a node from an earlier edit with the same polygon edge, all of the part is on
+        // its left and the edge is done
+        line_t const& l = bsp.nodes[nid].plane.line;
+        auto same_edge = [&](line_t const& e) { return e.p == l.p && e.q == l.q; };
+        if (std::any_of(ctx.lines.begin(), ctx.lines.end(), same_edge)) {
+            convex_poly_t &part = item.piece;
+            for (size_t k=0, n=part.verts.size(); k<n; k++)
+                if (NULL_ID == part.tags[k] && same_edge(ctx.lines[polygon_edge(ctx, part.verts[k], part.verts[(k + 1) % n])]))
+                    part.tags[k] = nid;
+            stack.push_back({bsp.planes[nid].left, nid, true, std::move(part)});
+            continue;
+        }
+
+        split_poly(item.piece, bsp.planes[nid], nid, right, left);
+        if (!right.verts.empty()) stack.push_back({bsp.planes[nid].right, nid, false, right});
+        if (!left.verts.empty()) stack.push_back({bsp.planes[nid].left, nid, true, left});
+    }
+
+    // nodes left with two leaves of the same kind become a leaf, up the tree
+    if (!ctx.collapse.empty()) {
+        std::vector<id_t> parents(bsp.size(), NULL_ID);
+        for (id_t i=0; i<bsp.size(); i++) {
+            if (!is_leaf(bsp.nodes[i].right)) parents[bsp.nodes[i].right] = i;
+            if (!is_leaf(bsp.nodes[i].left)) parents[bsp.nodes[i].left] = i;
+        }
+        for (id_t i : ctx.collapse) {
+            while (0 != i && NULL_ID != parents[i]) {
+                bsp_node_t const& n = bsp.nodes[i];
+                if (!is_leaf(n.right) || !is_leaf(n.left) || solid_leaf(n.right) != solid_leaf(n.left)) break;
+                id_t p = parents[i];
+                ctx.free_leaves.push_back(n.left & ~(IS_LEAF | IS_SOLID));
+                ctx.changed.push_back(n.left & ~(IS_LEAF | IS_SOLID));
+                ctx.changed.push_back(n.right & ~(IS_LEAF | IS_SOLID)); // grows into the left cell
+                set_child(bsp, p, bsp.nodes[p].left == i, n.right);
+                ctx.free_nodes.push_back(i);
+                parents[i] = NULL_ID;
+                i = p;
+            }
+        }
+    }
+
+    // close the gaps of removed nodes, keeping the order of the others
+    if (!ctx.free_nodes.empty()) {
+        std::vector<id_t> remap(bsp.size(), 0);
+        for (id_t i : ctx.free_nodes) remap[i] = NULL_ID;
+        id_t acc = 0;
+        for (id_t i=0; i<bsp.size(); i++)
+            if (NULL_ID != remap[i]) remap[i] = acc++;
+        for (id_t i=0; i<bsp.size(); i++) {
+            if (NULL_ID == remap[i]) continue;
+            bsp_node_t n = bsp.nodes[i];
+            if (!is_leaf(n.right)) n.right = remap[n.right];
+            if (!is_leaf(n.left)) n.left = remap[n.left];
+            bsp.nodes[remap[i]] = n;
+            bsp.planes[remap[i]] = bsp.planes[i];
+            bsp.planes[remap[i]].right = n.right;
+            bsp.planes[remap[i]].left = n.left;
+        }
+        bsp.nodes.resize(acc);
+        bsp.planes.resize(acc);
+    }
+
+    // leaf ids stay dense: leaves past the new count move into the freed ids below it
+    if (!ctx.free_leaves.empty()) {
+        id_t n_leaves = bsp.size() + 1;
+        std::vector<id_t> holes;
+        for (id_t id : ctx.free_leaves)
+            if (id < n_leaves) holes.push_back(id);
+        std::sort(holes.begin(), holes.end());
+        size_t next = 0;
+        for (id_t i=0; i<bsp.size(); i++) {
+            for (bool b_left : {false, true}) {
+                id_t child = b_left ? bsp.nodes[i].left : bsp.nodes[i].right;
+                id_t id = child & ~(IS_LEAF | IS_SOLID);
+                if (!is_leaf(child) || id < n_leaves) continue;
+                assert(next < holes.size());
+                ctx.changed.push_back(id);
+                set_child(bsp, i, b_left, (holes[next++] | IS_LEAF) | (child & IS_SOLID));
+            }
+        }
+        assert(next == holes.size());
+    }
+
+    if (!bsp.bounds.empty()) compute_bounds(bsp);
+
+    std::sort(ctx.changed.begin(), ctx.changed.end());
+    ctx.changed.erase(std::unique(ctx.changed.begin(), ctx.changed.end()), ctx.changed.end());
+    changed_leaves = std::move(ctx.changed);
+}
+
 } // namespace
 
 // build bsp-tree from lines
-bsp_t build(std::vector<line_t> lines) {
+bsp_t build(std::vector<line_t> lines, build_options_t const& options, build_stats_t *stats) {
     assert(lines.size() > 0);
 
-    std::vector<paramline_t> paramlines;
-    paramlines.insert(paramlines.end(), lines.begin(), lines.end());
-
-    return build(paramlines);
+    build_context_t ctx(options.memory);
+    ctx.tmp.reserve(build_size_estimate(lines.size()));
+    ctx.tmp.insert(ctx.tmp.end(), lines.begin(), lines.end());
+    return build_tree(ctx, options, stats);
 }
 
-bsp_t build(std::vector<paramline_t> paramlines) {
+bsp_t build(std::vector<paramline_t> paramlines, build_options_t const& options, build_stats_t *stats) {
     assert(paramlines.size() > 0);
 
-    build_context_t ctx;
-    ctx.leaf_id_acc = 0;
-    ctx.tmp = std::move(paramlines);
-
-    // select root hyperplane
-    id_t i_h = h_geometric_mean(ctx.tmp, 0, ctx.tmp.size());
-    paramline_t hyperplane = ctx.tmp[i_h];
-    ctx.tmp[i_h] = ctx.tmp.back(); ctx.tmp.pop_back();
-    build_impl(ctx, hyperplane, 0, ctx.tmp.size());
+    build_context_t ctx(options.memory);
+    ctx.tmp.reserve(build_size_estimate(paramlines.size()));
+    ctx.tmp.assign(paramlines.begin(), paramlines.end());
+    return build_tree(ctx, options, stats);
+}
 
-    return ctx.nodes;
+bsp_plane_t make_plane(paramline_t const& plane, id_t right, id_t left) {
+    // use the unscaled line for precision, t1 > t2 flips the direction
+    line_t const& l = plane.line;
+    double sign = (plane.t1 < plane.t2) ? 1.0 : -1.0;
+    double dx = ((double)l.q.x - l.p.x) * sign;
+    double dy = ((double)l.q.y - l.p.y) * sign;
+    double len = sqrt(dx*dx + dy*dy);
+    assert(len > 0.0);
+
+    bsp_plane_t h;
+    h.nx = (float)(-dy / len);
+    h.ny = (float)(dx / len);
+    h.d = (float)((-dy * l.p.x + dx * l.p.y) / len);
+    h.right = right;
+    h.left = left;
+    return h;
 }
 
 bool is_solid(bsp_t const& bsp, id_t nid, vec2_t const& point) {
-    // recurse until leaf
-    if (empty_leaf(nid)) return false;
-    if (solid_leaf(nid)) return true;
+    return is_solid_impl(bsp, nid, point);
+}
 
-    bsp_node_t const& node = bsp[nid];
-    if (point.is_left_of(node.plane.apply())) {
-        return is_solid(bsp, node.left, point);
-    } else {
-        return is_solid(bsp, node.right, point);
-    }
+bool is_solid(bsp_view_t const& bsp, id_t nid, vec2_t const& point) {
+    return is_solid_impl(bsp, nid, point);
 }
 
 id_t leaf_id(bsp_t const& bsp, id_t nid, vec2_t const& point) {
-    if (is_leaf(nid)) return (nid & ~IS_LEAF) & ~IS_SOLID;
+    return leaf_id_impl(bsp, nid, point);
+}
 
-    bsp_node_t const& node = bsp[nid];
-    if (point.is_left_of(node.plane.apply())) {
-        return leaf_id(bsp, node.left, point);
+id_t leaf_id(bsp_view_t const& bsp, id_t nid, vec2_t const& point) {
+    return leaf_id_impl(bsp, nid, point);
+}
+
+void classify_points(bsp_t const& bsp, std::span<vec2_t const> points, std::span<uint8_t> solid, std::span<id_t> leaf_ids) {
+    classify_impl(bsp, points, solid, leaf_ids);
+}
+
+void classify_points(bsp_view_t const& bsp, std::span<vec2_t const> points, std::span<uint8_t> solid, std::span<id_t> leaf_ids) {
+    classify_impl(bsp, points, solid, leaf_ids);
+}
+
+vec2i_t to_fixed(vec2_t const& p) {
+    // scaling by a power of two is exact, only the rounding to int changes p
+    assert(fabsf(p.x) * FIXED_ONE < FIXED_LIMIT && fabsf(p.y) * FIXED_ONE < FIXED_LIMIT);
+    return {(int32_t)lroundf(p.x * FIXED_ONE), (int32_t)lroundf(p.y * FIXED_ONE)};
+}
+
+vec2_t from_fixed(vec2i_t const& p) {
+    return vec2_t{(float)p.x, (float)p.y} / (float)FIXED_ONE;
+}
+
+fixed_bsp_t to_fixed(bsp_t const& bsp) {
+    fixed_bsp_t out;
+    out.planes.reserve(bsp.size());
+    for (bsp_node_t const& n : bsp) {
+        // the whole line as in make_plane, t1 > t2 flips the direction
+        vec2i_t p = to_fixed(n.plane.line.p);
+        vec2i_t q = to_fixed(n.plane.line.q);
+        if (n.plane.t1 > n.plane.t2) std::swap(p, q);
+        assert(p != q);
+
+        fixed_plane_t h;
+        h.a = p.y - q.y;
+        h.b = q.x - p.x;
+        h.c = (int64_t)h.a * p.x + (int64_t)h.b * p.y;
+        h.right = n.right;
+        h.left = n.left;
+        out.planes.push_back(h);
+    }
+    return out;
+}
+
+bool is_solid(fixed_bsp_t const& bsp, id_t nid, vec2i_t const& point) {
+    return is_solid_impl(bsp, nid, point);
+}
+
+id_t leaf_id(fixed_bsp_t const& bsp, id_t nid, vec2i_t const& point) {
+    return leaf_id_impl(bsp, nid, point);
+}
+
+bool sweep(fixed_bsp_t const& bsp, vec2i_t const& p, vec2i_t const& q, vec2i_t &hit, id_t &hit_nid) {
+    return fixed_sweep_impl(bsp, p, q, hit, hit_nid);
+}
+
+void sweep_many(bsp_t const& bsp, std::span<line_t const> lines, std::span<sweep_hit_t> hits, thread_pool_t *pool) {
+    assert(lines.size() == hits.size());
+
+    // groups of nearby lines share the walk down, far apart ones part at the root
+    constexpr size_t group = 64;
+    auto run = [&](size_t begin, size_t end) {
+        for (size_t i=begin; i<end; i+=group) {
+            size_t n = std::min(group, end - i);
+            sweep_group(bsp, lines.subspan(i, n), hits.subspan(i, n));
+        }
+    };
+
+    if (pool) {
+        pool->parallel_for(lines.size(), group * 4, run);
     } else {
-        return leaf_id(bsp, node.right, point);
+        run(0, lines.size());
     }
 }
 
 bool sweep(bsp_t const& bsp, line_t const& line, vec2_t &intersection, line_t &intersected) {
-    return sweep_impl(bsp, 0, line, 0.f, 1.f, paramline_t(), intersection, intersected);
+    return sweep_impl(bsp, 0, line, 0.f, 1.f, NULL_ID, intersection, intersected);
+}
+
+bool sweep(bsp_view_t const& bsp, line_t const& line, vec2_t &intersection, line_t &intersected) {
+    return sweep_impl(bsp, 0, line, 0.f, 1.f, NULL_ID, intersection, intersected);
+}
+
+bool clip(clip_context_t &ctx, id_t root) {
+    return clip_impl(ctx, root, ctx.paramline->t1, ctx.paramline->t2);
+}
+
+void compute_bounds(bsp_t &bsp) {
+    // padded, so that a line through the end of a segment reaches its box
+    constexpr float pad = 1e-3f;
+    bsp.bounds.resize(bsp.size());
+    if (bsp.empty()) return;
+
+    // children before their parent, the edits don't keep them at higher ids
+    std::vector<std::pair<id_t, bool>> stack = {{0, false}};
+    while (!stack.empty()) {
+        auto [nid, b_children_done] = stack.back();
+        stack.pop_back();
+        bsp_node_t const& n = bsp.nodes[nid];
+        if (!b_children_done) {
+            stack.push_back({nid, true});
+            if (!is_leaf(n.right)) stack.push_back({n.right, false});
+            if (!is_leaf(n.left)) stack.push_back({n.left, false});
+            continue;
+        }
+
+        line_t l = n.plane.apply();
+        bsp_bounds_t b = {{std::min(l.p.x, l.q.x) - pad, std::min(l.p.y, l.q.y) - pad},
+                          {std::max(l.p.x, l.q.x) + pad, std::max(l.p.y, l.q.y) + pad}};
+        for (id_t child : {n.right, n.left}) {
+            if (is_leaf(child)) continue;
+            bsp_bounds_t const& c = bsp.bounds[child];
+            b.min = {std::min(b.min.x, c.min.x), std::min(b.min.y, c.min.y)};
+            b.max = {std::max(b.max.x, c.max.x), std::max(b.max.y, c.max.y)};
+        }
+        bsp.bounds[nid] = b;
+    }
+}
+
+bool query_stats_enabled() {
+#if defined(ALH_BSP_STATS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+query_stats_t &query_stats() {
+    return t_query_stats;
+}
+
+tree_stats_t tree_stats(bsp_t const& bsp) {
+    tree_stats_t out = {};
+    out.node_count = bsp.size();
+    out.bytes = bsp.planes.capacity() * sizeof(bsp_plane_t) + bsp.nodes.capacity() * sizeof(bsp_node_t)
+              + bsp.bounds.capacity() * sizeof(bsp_bounds_t);
+    if (bsp.empty()) return out;
+
+    for (bsp_node_t const& n : bsp) {
+        float t_min = std::min(n.plane.t1, n.plane.t2), t_max = std::max(n.plane.t1, n.plane.t2);
+        if (t_min != 0.f || t_max != 1.f) out.split_segments++;
+    }
+
+    uint64_t depth_acc = 0;
+    std::vector<std::pair<id_t, uint32_t>> stack = {{0, 0}};
+    while (!stack.empty()) {
+        auto [nid, depth] = stack.back();
+        stack.pop_back();
+        if (is_leaf(nid)) {
+            if (solid_leaf(nid)) out.solid_leaves++;
+            else out.empty_leaves++;
+            if (out.depth_histogram.size() <= depth) out.depth_histogram.resize(depth + 1, 0);
+            out.depth_histogram[depth]++;
+            out.depth = std::max(out.depth, depth);
+            depth_acc += depth;
+            continue;
+        }
+        stack.push_back({bsp.nodes[nid].right, depth + 1});
+        stack.push_back({bsp.nodes[nid].left, depth + 1});
+    }
+    out.mean_depth = (float)depth_acc / (out.solid_leaves + out.empty_leaves);
+    return out;
+}
+
+convex_poly_t bounds_poly(vec2_t const& min, vec2_t const& max, std::pmr::memory_resource *memory) {
+    if (!memory) memory = std::pmr::get_default_resource();
+    vec2_t margin = (max - min) * 0.5f + vec2_t{1.f, 1.f};
+    vec2_t lo = min - margin, hi = max + margin;
+
+    convex_poly_t out = make_poly(memory);
+    out.verts = {lo, {hi.x, lo.y}, hi, {lo.x, hi.y}};
+    out.tags.assign(4, NULL_ID);
+    return out;
 }
 
 void dot_solve(bsp_t const& bsp, vec2_t const& p1, vec2_t &p2) {
-    // repeat sweep and dot projection until p2 isn't solid
-    vec2_t intersection;
-    line_t line;
-    while (sweep(bsp, {p1, p2}, intersection, line)) {
-        if (p2.is_left_of(line))
-            p2 = project_to(p2, line) + line.normal * 0.1;
-        else
-            p2 = project_to(p2, line) - line.normal * 0.1;
+    p2 = slide_move(bsp, p1, p2).position;
+}
+
+move_result_t slide_move(bsp_t const& bsp, vec2_t const& p1, vec2_t const& p2) {
+    // each leg sweeps only what is left of the move, from where the last one stopped
+    move_result_t out;
+    out.n_contacts = 0;
+    vec2_t p = p1;
+    vec2_t d = p2 - p1;
+    auto dot = [](vec2_t a, vec2_t b) { return a.x * b.x + a.y * b.y; };
+
+    while (d != vec2_t{0.f, 0.f}) {
+        vec2_t hit;
+        line_t plane;
+        BSP_COUNT(move_legs, 1);
+        if (!sweep(bsp, {p, p + d}, hit, plane)) {
+            p = p + d;
+            break;
+        }
+        if (plane.p == plane.q) break; // started in solid
+
+        // stop short of the wall by the skin, everything before it is empty
+        vec2_t n = plane.normal;
+        float s = dot(p - plane.p, n);
+        if (s < 0.f) {
+            n = vec2_t{0.f, 0.f} - n;
+            s = -s;
+        }
+        float v = dot(d, n);
+        if (v > -1e-6f) { // grazing, stop where it met solid
+            p = hit;
+            break;
+        }
+        float t = std::clamp((s - MOVE_SKIN) / -v, 0.f, 1.f);
+        p = p + d * t;
+        if (MAX_MOVE_CONTACTS == out.n_contacts) break;
+
+        // slide along the wall, into a wall touched before is a corner
+        vec2_t rest = d * (1.f - t);
+        rest = rest - n * dot(rest, n);
+        for (uint32_t k=0; k<out.n_contacts; k++)
+            if (dot(rest, out.normals[k]) < 0.f) rest = {0.f, 0.f};
+        out.normals[out.n_contacts++] = n;
+        d = rest;
     }
+
+    out.position = p;
+    return out;
 }
 
-bsp_t union_op(bsp_t const& a, bsp_t const& b) {
-    
-    assert(!(a.empty() && b.empty()));
-    if (a.empty() ^ b.empty()) { // short circuit if empty operand
-        return (a.empty()) ? b : a;
+void slide_move_many(bsp_t const& bsp, std::span<vec2_t const> from, std::span<vec2_t const> to, std::span<move_result_t> out, thread_pool_t *pool) {
+    assert(from.size() == to.size() && from.size() == out.size());
+
+    auto run = [&](size_t begin, size_t end) {
+        for (size_t i=begin; i<end; i++) out[i] = slide_move(bsp, from[i], to[i]);
+    };
+
+    if (pool) {
+        pool->parallel_for(from.size(), 256, run);
+    } else {
+        run(0, from.size());
     }
+}
 
-    std::vector<paramline_t> out;
-    clip_context_t ctx;
-    ctx.userdata = &out;
-    ctx.on_solid = cb_do_nothing;
-    ctx.on_empty = cb_push_segment;
-    ctx.bsp = &a;
+void split_poly(convex_poly_t const& poly, bsp_plane_t const& h, id_t nid, convex_poly_t &right, convex_poly_t &left) {
+    right.verts.clear(); right.tags.clear();
+    left.verts.clear(); left.tags.clear();
+
+    size_t n = poly.verts.size();
+    for (size_t k=0; k<n; k++) {
+        vec2_t a = poly.verts[k];
+        vec2_t b = poly.verts[(k + 1) % n];
+        bool l_a = h.is_left(a);
+        bool l_b = h.is_left(b);
+
+        convex_poly_t &same = l_a ? left : right;
+        same.verts.push_back(a);
+        same.tags.push_back(poly.tags[k]);
+        if (l_a == l_b) continue;
+
+        // edge crosses the plane: it goes on in the other part, this one follows the plane
+        double s_a = (double)h.nx * a.x + (double)h.ny * a.y - h.d;
+        double s_b = (double)h.nx * b.x + (double)h.ny * b.y - h.d;
+        double t = s_a / (s_a - s_b);
+        vec2_t x = {(float)(a.x + (b.x - a.x) * t), (float)(a.y + (b.y - a.y) * t)};
+
+        convex_poly_t &other = l_a ? right : left;
+        same.verts.push_back(x);
+        same.tags.push_back(nid);
+        other.verts.push_back(x);
+        other.tags.push_back(poly.tags[k]);
+    }
 
-    for (bsp_node_t n : b) {
-        ctx.paramline = &n.plane;
-        clip_impl(ctx, 0, n.plane.t1, n.plane.t2);
+    for (convex_poly_t *part : {&right, &left}) {
+        if (part->verts.size() < 3) {
+            part->verts.clear();
+            part->tags.clear();
+        }
     }
+}
 
-    ctx.bsp = &b;
+std::vector<uint8_t> serialize(bsp_t const& in) {
+    std::vector<uint8_t> out;
+    out.reserve(HEADER_SIZE + in.size() * (sizeof(bsp_plane_t) + sizeof(flat_node_t)));
+
+    put_u32(out, FORMAT_MAGIC);
+    put_u32(out, FORMAT_VERSION);
+    put_u32(out, in.size());
+    put_u32(out, 0);
+
+    for (bsp_plane_t const& h : in.planes) {
+        put_f32(out, h.nx);
+        put_f32(out, h.ny);
+        put_f32(out, h.d);
+        put_u32(out, h.right);
+        put_u32(out, h.left);
+    }
 
-    for (bsp_node_t n : a) {
-        ctx.paramline = &n.plane;
-        clip_impl(ctx, 0, n.plane.t1, n.plane.t2);
+    for (bsp_node_t const& n : in) {
+        // userdata is a pointer and is not stored
+        put_f32(out, n.plane.line.p.x);
+        put_f32(out, n.plane.line.p.y);
+        put_f32(out, n.plane.line.q.x);
+        put_f32(out, n.plane.line.q.y);
+        put_f32(out, n.plane.t1);
+        put_f32(out, n.plane.t2);
+        put_u32(out, n.right);
+        put_u32(out, n.left);
     }
-    
-    return build(out);
+
+    return out;
 }
 
-bsp_t intersect_op(bsp_t const& a, bsp_t const& b) {
+bool view(uint8_t const* data, size_t len, bsp_view_t &out) {
+    // nodes are read in place, which needs a little-endian host and 4-byte alignment
+    if constexpr (std::endian::native != std::endian::little) return false;
+    if (0 != (uintptr_t)data % alignof(flat_node_t)) return false;
 
-    std::vector<paramline_t> out;
-    clip_context_t ctx;
-    ctx.userdata = &out;
-    ctx.on_solid = cb_push_segment;
-    ctx.on_empty = cb_do_nothing;
-    ctx.bsp = &a;
+    size_t n_nodes = check_blob(data, len);
+    if (0 == n_nodes) return false;
+
+    out.planes = (bsp_plane_t const*)(data + HEADER_SIZE);
+    out.nodes = (flat_node_t const*)(data + HEADER_SIZE + n_nodes * sizeof(bsp_plane_t));
+    out.size = n_nodes;
+    return true;
+}
 
-    for (bsp_node_t n : b) {
-        ctx.paramline = &n.plane;
-        clip_impl(ctx, 0, n.plane.t1, n.plane.t2);
+bsp_t deserialize(uint8_t const* data, size_t len) {
+    // copies field by field, so unlike view() any host and alignment will do
+    size_t n_nodes = check_blob(data, len);
+    if (0 == n_nodes) return {};
+
+    bsp_t out;
+    out.planes.reserve(n_nodes);
+    out.nodes.reserve(n_nodes);
+    for (uint8_t const* in = data + HEADER_SIZE; out.planes.size() < n_nodes; in += sizeof(bsp_plane_t))
+        out.planes.push_back({get_f32(in), get_f32(in + 4), get_f32(in + 8), get_u32(in + 12), get_u32(in + 16)});
+    for (uint8_t const* in = data + HEADER_SIZE + n_nodes * sizeof(bsp_plane_t); out.nodes.size() < n_nodes; in += sizeof(flat_node_t)) {
+        line_t l = {{get_f32(in), get_f32(in + 4)}, {get_f32(in + 8), get_f32(in + 12)}, nullptr};
+        out.nodes.push_back({paramline_t(l, get_f32(in + 16), get_f32(in + 20)), get_u32(in + 24), get_u32(in + 28)});
     }
+    return out;
+}
 
-    ctx.bsp = &b;
+// a is walked and b copied into its leaves, walking the larger tree keeps the copies small
+bsp_t union_op(bsp_t const& a, bsp_t const& b, std::pmr::memory_resource *memory) {
+    if (a.empty() && b.empty()) return make_tree(memory);
+    if (a.empty() ^ b.empty()) { // short circuit if empty operand
+        return copy_tree((a.empty()) ? b : a, memory);
+    }
 
-    for (bsp_node_t n : a) {
-        ctx.paramline = &n.plane;
-        clip_impl(ctx, 0, n.plane.t1, n.plane.t2);
+    // apart from each other nothing has to be copied, a line between them keeps them apart
+    vec2_t a_min, a_max, b_min, b_max;
+    if (!tree_extent(a, a_min, a_max) && !tree_extent(b, b_min, b_max)) {
+        vec2_t min = {std::min(a_min.x, b_min.x), std::min(a_min.y, b_min.y)};
+        vec2_t max = {std::max(a_max.x, b_max.x), std::max(a_max.y, b_max.y)};
+        if (a_max.x < b_min.x || b_max.x < a_min.x) {
+            float x = (a_max.x < b_min.x) ? (a_max.x + b_min.x) / 2.f : (b_max.x + a_min.x) / 2.f;
+            vec2_t p = {x, min.y - 1.f}, q = {x, max.y + 1.f};
+            return make_plane(paramline_t({p, q}), 0, 0).is_left(a_min) ? join(b, a, p, q, memory) : join(a, b, p, q, memory);
+        }
+        if (a_max.y < b_min.y || b_max.y < a_min.y) {
+            float y = (a_max.y < b_min.y) ? (a_max.y + b_min.y) / 2.f : (b_max.y + a_min.y) / 2.f;
+            vec2_t p = {min.x - 1.f, y}, q = {max.x + 1.f, y};
+            return make_plane(paramline_t({p, q}), 0, 0).is_left(a_min) ? join(b, a, p, q, memory) : join(a, b, p, q, memory);
+        }
     }
-    
-    return build(out);
+
+    return (a.size() < b.size()) ? merge(b, a, 0b1110, memory) : merge(a, b, 0b1110, memory);
 }
 
-bsp_t difference_op(bsp_t const& a, bsp_t const& b) {
+bsp_t intersect_op(bsp_t const& a, bsp_t const& b, std::pmr::memory_resource *memory) {
+    if (a.empty() || b.empty()) return make_tree(memory);
+    return (a.size() < b.size()) ? merge(b, a, 0b1000, memory) : merge(a, b, 0b1000, memory);
+}
 
-    std::vector<paramline_t> out;
-    clip_context_t ctx;
-    ctx.userdata = &out;
-    ctx.on_solid = cb_push_flipped_segment;
-    ctx.on_empty = cb_do_nothing;
-    ctx.bsp = &a;
+bsp_t difference_op(bsp_t const& a, bsp_t const& b, std::pmr::memory_resource *memory) {
+    if (a.empty() || b.empty()) return copy_tree(a, memory);
+    return merge(a, b, 0b0100, memory);
+}
 
-    for (bsp_node_t n : b) {
-        ctx.paramline = &n.plane;
-        clip_impl(ctx, 0, n.plane.t1, n.plane.t2);
+bsp_t xor_op(bsp_t const& a, bsp_t const& b, std::pmr::memory_resource *memory) {
+    if (a.empty() || b.empty()) return copy_tree((a.empty()) ? b : a, memory);
+    return (a.size() < b.size()) ? merge(b, a, 0b0110, memory) : merge(a, b, 0b0110, memory);
+}
+
+bsp_t union_all(std::span<bsp_t const> trees, thread_pool_t *pool) {
+    if (trees.empty()) return {};
+    if (1 == trees.size()) return trees[0];
+
+    // pair up trees that are close to each other, in morton order of their centers, so
+    // that the copies go into few leaves of the other tree
+    static constexpr float inf = std::numeric_limits<float>::infinity();
+    std::vector<vec2_t> centers(trees.size());
+    vec2_t min = {inf, inf}, max = {-inf, -inf};
+    for (size_t i=0; i<trees.size(); i++) {
+        vec2_t acc = {0.f, 0.f};
+        for (bsp_node_t const& n : trees[i]) {
+            line_t l = n.plane.apply();
+            acc = acc + l.p + l.q;
+        }
+        centers[i] = trees[i].empty() ? acc : acc / (2.f * trees[i].size());
+        min = {std::min(min.x, centers[i].x), std::min(min.y, centers[i].y)};
+        max = {std::max(max.x, centers[i].x), std::max(max.y, centers[i].y)};
     }
 
-    ctx.on_solid = cb_do_nothing;
-    ctx.on_empty = cb_push_segment;
-    ctx.bsp = &b;
+    std::vector<std::pair<uint32_t, uint32_t>> order(trees.size()); // code, index
+    vec2_t scale = {65535.f / std::max(max.x - min.x, 1e-6f), 65535.f / std::max(max.y - min.y, 1e-6f)};
+    for (uint32_t i=0; i<trees.size(); i++) {
+        uint32_t x = (centers[i].x - min.x) * scale.x, y = (centers[i].y - min.y) * scale.y;
+        uint32_t code = 0;
+        for (int k=0; k<16; k++) code |= (((x >> k) & 1) << (2 * k)) | (((y >> k) & 1) << (2 * k + 1));
+        order[i] = {code, i};
+    }
+    std::sort(order.begin(), order.end());
+
+    // then merge neighbors level by level, the pairs of a level are independent
+    std::vector<bsp_t> level(trees.size());
+    std::vector<bsp_t> next;
+    for (size_t i=0; i<trees.size(); i++) level[i] = trees[order[i].second];
+    while (level.size() > 1) {
+        next.assign((level.size() + 1) / 2, bsp_t{});
+        auto merge_pairs = [&](size_t begin, size_t end) {
+            for (size_t i=begin; i<end; i++) {
+                if (2 * i + 1 == level.size()) next[i] = std::move(level[2 * i]);
+                else if (level[2 * i].empty() && level[2 * i + 1].empty()) next[i] = {};
+                else next[i] = union_op(level[2 * i], level[2 * i + 1]);
+            }
+        };
+        if (pool) pool->parallel_for(next.size(), 1, merge_pairs);
+        else merge_pairs(0, next.size());
+        std::swap(level, next);
+    }
+    return std::move(level[0]);
+}
 
-    for (bsp_node_t n : a) {
-        ctx.paramline = &n.plane;
-        clip_impl(ctx, 0, n.plane.t1, n.plane.t2);
+bsp_t rebalance(bsp_t const& bsp, build_options_t const& options, build_stats_t *stats) {
+    std::vector<paramline_t> segments;
+    if (!bsp.empty()) segments = boundary_segments(bsp);
+    if (segments.empty()) { // all solid or all empty, nothing to place
+        if (stats) *stats = {tree_stats(bsp).depth, (uint32_t)bsp.size(), (uint32_t)(bsp.size() + 1), 0, 0};
+        return copy_tree(bsp, options.memory);
     }
-    
-    return build(out);
+    return build(std::move(segments), options, stats);
+}
+
+void insert_obstacle(bsp_t &bsp, std::span<vec2_t const> poly, std::vector<id_t> &changed_leaves) {
+    edit_obstacle(bsp, poly, true, changed_leaves);
 }
 
-bsp_t xor_op(bsp_t const& a, bsp_t const& b) {
-    bsp_t a_sub_b = difference_op(a, b);
-    bsp_t b_sub_a = difference_op(b, a);
-    return union_op(a_sub_b, b_sub_a);
+void remove_obstacle(bsp_t &bsp, std::span<vec2_t const> poly, std::vector<id_t> &changed_leaves) {
+    edit_obstacle(bsp, poly, false, changed_leaves);
 }
 
 } // namespace alh::bsp
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bsp.hpp"
+#include "bsp_stl.hpp"
+#include "navmesh.hpp"
+#include "thread_pool.hpp"
+
+using namespace alh;
+
+// offline map compiler, builds the tree and navmesh of a map once so that loading
+// it does no geometry work
+//
+// usage: bspc input [--out map.bsp] [--navmesh map.nav] [--header map.h] [--name NAME]
+//             [--samples N] [--points N]
+//
+// input is an .stl, or a text file with one segment "px py qx qy" per line (solid
+// space to the left, as for build). several build options are tried and the tree
+// with the fewest planes per point query is kept. --out and --navmesh write the
+// serialize() blobs, --header writes both as arrays NAME_bsp and NAME_navmesh
+
+namespace {
+
+struct options_t {
+    std::string input, out, navmesh, header, name;
+    uint32_t n_samples = std::numeric_limits<uint32_t>::max(); // candidates per node, all by default
+    size_t n_points = 65536; // query points for scoring a tree
+};
+
+bool read_file(std::string const& path, std::vector<uint8_t> &out) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    uint8_t buf[1 << 16];
+    for (size_t n; (n = fread(buf, 1, sizeof(buf), f)) > 0;) out.insert(out.end(), buf, buf + n);
+    fclose(f);
+    return true;
+}
+
+bool is_stl(std::string const& path) {
+    std::string ext = path.substr(path.find_last_of('.') + 1);
+    for (char &c : ext) c = tolower(c);
+    return "stl" == ext;
+}
+
+std::vector<line_t> read_lines(std::vector<uint8_t> const& data) {
+    // one segment per line, blank lines and lines starting with # are skipped
+    std::vector<line_t> lines;
+    std::string text(data.begin(), data.end());
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = text.find('\n', begin);
+        if (std::string::npos == end) end = text.size();
+        std::string row = text.substr(begin, end - begin);
+        begin = end + 1;
+
+        line_t l = {};
+        if (4 == sscanf(row.c_str(), " %f %f %f %f", &l.p.x, &l.p.y, &l.q.x, &l.q.y) && l.p != l.q) {
+            lines.push_back(l);
+        } else if (row.find_first_not_of(" \t\r") != std::string::npos && '#' != row[row.find_first_not_of(" \t\r")]) {
+            fprintf(stderr, "skipping line: %s\n", row.c_str());
+        }
+    }
+    return lines;
+}
+
+// mean planes tested by is_solid over points spread evenly in the map box, the
+// points come from a fixed seed so the same input gives the same tree
+double query_cost(bsp::bsp_t const& bsp, std::vector<vec2_t> const& points) {
+    size_t n_planes = 0;
+    for (vec2_t const& p : points) {
+        for (bsp::id_t nid = 0; !bsp::is_leaf(nid); nid = bsp.planes[nid].child(p)) n_planes++;
+    }
+    return (double)n_planes / std::max<size_t>(points.size(), 1);
+}
+
+bool write_file(std::string const& path, std::vector<uint8_t> const& data) {
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f) return false;
+    bool b_ok = (data.size() == fwrite(data.data(), 1, data.size(), f));
+    return (0 == fclose(f)) && b_ok;
+}
+
+void put_array(std::string &out, std::string const& name, std::vector<uint8_t> const& data) {
+    // aligned so bsp::view() can read the array in place
+    char buf[64];
+    out += "alignas(16) unsigned char " + name + "[] = {";
+    for (size_t i=0; i<data.size(); i++) {
+        snprintf(buf, sizeof(buf), "%s%s0x%02x", (0 == i) ? "" : ",", (0 == i % 12) ? "\n  " : " ", data[i]);
+        out += buf;
+    }
+    snprintf(buf, sizeof(buf), "\n};\nunsigned int %s_len = %zu;\n", name.c_str(), data.size());
+    out += buf;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+
+    options_t opt;
+    for (int i=1; i<argc; i++) {
+        char const* arg = argv[i];
+        if ('-' != arg[0]) {
+            opt.input = arg;
+            continue;
+        }
+
+        char const* val = (i + 1 < argc) ? argv[i+1] : nullptr;
+        if (!val) {
+            fprintf(stderr, "missing value for %s\n", arg);
+            return 1;
+        }
+
+        if (0 == strcmp(arg, "--out")) {
+            opt.out = val;
+        } else if (0 == strcmp(arg, "--navmesh")) {
+            opt.navmesh = val;
+        } else if (0 == strcmp(arg, "--header")) {
+            opt.header = val;
+        } else if (0 == strcmp(arg, "--name")) {
+            opt.name = val;
+        } else if (0 == strcmp(arg, "--samples")) {
+            opt.n_samples = strtoul(val, nullptr, 10);
+        } else if (0 == strcmp(arg, "--points")) {
+            opt.n_points = strtoull(val, nullptr, 10);
+        } else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 1;
+        }
+        i++;
+    }
+
+    if (opt.input.empty() || (opt.out.empty() && opt.navmesh.empty() && opt.header.empty())) {
+        fprintf(stderr, "usage: bspc input [--out map.bsp] [--navmesh map.nav] [--header map.h] [--name NAME]\n"
+                        "            [--samples N] [--points N]\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> data;
+    if (!read_file(opt.input, data)) {
+        fprintf(stderr, "can't read %s\n", opt.input.c_str());
+        return 1;
+    }
+
+    std::vector<line_t> lines;
+    if (is_stl(opt.input)) {
+        if (data.size() <= 84) {
+            fprintf(stderr, "%s is too short for an .stl\n", opt.input.c_str());
+            return 1;
+        }
+        lines = bsp::stl_outline(data.data(), data.size());
+    } else {
+        lines = read_lines(data);
+    }
+    if (lines.empty()) {
+        fprintf(stderr, "no segments in %s\n", opt.input.c_str());
+        return 1;
+    }
+
+    vec2_t min = lines[0].p, max = lines[0].p;
+    for (line_t const& l : lines) {
+        for (vec2_t p : {l.p, l.q}) {
+            min = {std::min(min.x, p.x), std::min(min.y, p.y)};
+            max = {std::max(max.x, p.x), std::max(max.y, p.y)};
+        }
+    }
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> ux(min.x, max.x), uy(min.y, max.y);
+    std::vector<vec2_t> points(opt.n_points);
+    for (vec2_t &p : points) p = {ux(rng), uy(rng)};
+
+    // candidates, the cheapest tree wins and earlier ones win ties
+    std::vector<bsp::build_options_t> candidates;
+    candidates.push_back({});
+    for (float split_weight : {1.f, 4.f, 16.f}) {
+        for (float balance_weight : {0.5f, 2.f}) {
+            bsp::build_options_t o;
+            o.heuristic = bsp::split_heuristic_t::sampled_cost;
+            o.n_samples = opt.n_samples;
+            o.split_weight = split_weight;
+            o.balance_weight = balance_weight;
+            candidates.push_back(o);
+        }
+    }
+
+    thread_pool_t pool;
+    bsp::bsp_t best;
+    double best_cost = std::numeric_limits<double>::infinity();
+    for (bsp::build_options_t o : candidates) {
+        o.pool = &pool;
+        bsp::build_stats_t stats;
+        bsp::bsp_t bsp = bsp::build(lines, o, &stats);
+        double cost = query_cost(bsp, points);
+        char label[64] = "geometric_mean";
+        if (bsp::split_heuristic_t::sampled_cost == o.heuristic)
+            snprintf(label, sizeof(label), "sampled_cost %g/%g", o.split_weight, o.balance_weight);
+        fprintf(stderr, "%-20s depth %u, %u nodes, %u splits, %.2f planes per query\n",
+                label, stats.depth, stats.node_count, stats.splits, cost);
+        if (cost < best_cost) {
+            best = std::move(bsp);
+            best_cost = cost;
+        }
+    }
+
+    std::vector<uint8_t> bsp_blob = bsp::serialize(best);
+    std::vector<uint8_t> nav_blob = bsp::navmesh::serialize(bsp::navmesh::build(best));
+
+    bool b_ok = true;
+    if (!opt.out.empty()) b_ok = write_file(opt.out, bsp_blob) && b_ok;
+    if (!opt.navmesh.empty()) b_ok = write_file(opt.navmesh, nav_blob) && b_ok;
+    if (!opt.header.empty()) {
+        std::string name = opt.name.empty() ? "map" : opt.name;
+        std::string input = opt.input.substr(opt.input.find_last_of("/\\") + 1);
+        std::string text = "// generated by bspc from " + input + ", load with bsp::deserialize() and\n"
+                           "// bsp::navmesh::deserialize()\n";
+        put_array(text, name + "_bsp", bsp_blob);
+        put_array(text, name + "_navmesh", nav_blob);
+        b_ok = write_file(opt.header, std::vector<uint8_t>(text.begin(), text.end())) && b_ok;
+    }
+
+    if (!b_ok) {
+        fprintf(stderr, "can't write output\n");
+        return 1;
+    }
+    return 0;
+}
@@ -3,11 +3,10 @@
 
 #include "raylib.h"
 #include "bsp.hpp"
-#include "bsp_stl.hpp"
 #include "navmesh.hpp"
 #include "dbg_shapes.hpp"
 
-#include "test.stl.h"
+#include "test.map.h" // bspc test.stl --header include/test.map.h --name test_map
 
 #if defined(PLATFORM_WEB)
     #include <emscripten/emscripten.h>
@@ -99,10 +98,37 @@ void draw_path(bsp::navmesh::navmesh_t const& navmesh, std::vector<size_t> const
 
 bsp::bsp_t g_bsp;
 bsp::navmesh::navmesh_t g_navmesh;
+bsp::navmesh::cells_t g_cells;
+bsp::tree_stats_t g_tree_stats;
+bool g_show_stats = false;
+
+void draw_stats(bsp::query_stats_t const& q) {
+    // tree shape and the query counters of this frame, top left
+    bsp::tree_stats_t const& t = g_tree_stats;
+    DrawText(TextFormat("nodes %u  solid %u  empty %u  splits %u  %.1f kb", t.node_count, t.solid_leaves,
+                        t.empty_leaves, t.split_segments, t.bytes / 1024.0), 4, 4, 10, YELLOW);
+    DrawText(TextFormat("depth %u  mean %.1f", t.depth, t.mean_depth), 4, 16, 10, YELLOW);
+    if (bsp::query_stats_enabled()) {
+        DrawText(TextFormat("frame: queries %llu  nodes %llu  splits %llu  stack %u  legs %llu",
+                            (unsigned long long)q.queries, (unsigned long long)q.nodes, (unsigned long long)q.splits,
+                            q.max_stack, (unsigned long long)q.move_legs), 4, 28, 10, YELLOW);
+    }
+
+    // leaves per depth, bars up from the bottom left
+    uint32_t most = 1;
+    for (uint32_t n : t.depth_histogram) most = std::max(most, n);
+    for (size_t d=0; d<t.depth_histogram.size(); d++) {
+        int h = 40 * t.depth_histogram[d] / most;
+        DrawRectangle(4 + 3 * d, 296 - h, 2, h, YELLOW);
+    }
+}
 
 void update_draw_frame() {
 
     // update
+    bsp::query_stats() = {};
+    if (IsKeyPressed(KEY_TAB)) g_show_stats = !g_show_stats;
+
     vec2_t next_pos = player_pos;
     if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) next_pos.x = player_pos.x + 1.f;
     if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) next_pos.x = player_pos.x - 1.f;
@@ -128,18 +154,12 @@ void update_draw_frame() {
     ClearBackground(BLACK);
 
     // draw polygons for empty leaves
-    auto ids = bsp::navmesh::empty_leaves(g_bsp);
-    for (auto id : ids) {
-        auto cell = bsp::navmesh::leaf_poly(g_bsp, id);
-        draw_tree(cell, 0, DARKGRAY);
-
-        // get center
-        vec2_t acc = {0, 0};
-        for (bsp::bsp_node_t n : cell)
-            acc = acc + n.plane.apply().p;
-        acc = acc / cell.size();
-
-        draw_cross(acc, 0x505050);
+    for (size_t i=0; i<g_cells.leaf_ids.size(); i++) {
+        for (size_t j=g_cells.cell_start[i]; j<g_cells.cell_start[i+1]; j++) {
+            line_t l = g_cells.edges[j].plane.apply();
+            DrawLineV({l.p.x, l.p.y}, {l.q.x, l.q.y}, DARKGRAY);
+        }
+        draw_cross(g_cells.centers[i], 0x505050);
     }
 
     SetRandomSeed(0xdeafbeef);
@@ -149,11 +169,10 @@ void update_draw_frame() {
     bsp::id_t id_player = bsp::leaf_id(g_bsp, 0, {player_pos.x, player_pos.y});
     
     if (!bsp::is_solid(g_bsp, 0, {mpos.x, mpos.y})) {
-        auto points = bsp::navmesh::find_path(g_bsp,
-                                              g_navmesh,
-                                              {player_pos.x, player_pos.y},
-                                              {mpos.x, mpos.y});
-        for (size_t i=0; i<points.size()-1; i++) {
+        static bsp::navmesh::path_query_context_t ctx;
+        static std::vector<vec2_t> points;
+        bsp::navmesh::find_path(g_bsp, g_navmesh, {player_pos.x, player_pos.y}, {mpos.x, mpos.y}, ctx, points);
+        for (size_t i=0; i+1<points.size(); i++) {
             vec2_t p1 = points[i];
             vec2_t p2 = points[i+1];
             dbg_line(p1.x, p1.y, p2.x, p2.y, 0xff00ff);
@@ -169,14 +188,15 @@ void update_draw_frame() {
     draw_navmesh(g_navmesh);
 
     dbg_shapes().draw();
+    if (g_show_stats) draw_stats(bsp::query_stats());
 
     EndDrawing();
 }
 
 int main() {
 
-    // build bsp from .stl
-    g_bsp = bsp::from_stl(test_stl, test_stl_len);
+    // tree and navmesh were baked offline from .stl by bspc
+    g_bsp = bsp::deserialize(test_map_bsp, test_map_bsp_len);
 
 //    std::vector<line_t> lines = {
 //        {{60, 40}, {340, 40}},
@@ -207,7 +227,9 @@ int main() {
 //    };
 //
 //    g_bsp = bsp::build(lines);
-    g_navmesh = bsp::navmesh::build(g_bsp);
+    g_navmesh = bsp::navmesh::deserialize(test_map_navmesh, test_map_navmesh_len);
+    g_cells = bsp::navmesh::cells(g_bsp);
+    g_tree_stats = bsp::tree_stats(g_bsp);
 
     InitWindow(400, 300, "BSP test");
 #if defined(PLATFORM_WEB)